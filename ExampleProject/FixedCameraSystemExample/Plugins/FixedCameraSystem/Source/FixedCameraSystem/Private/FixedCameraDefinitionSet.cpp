@@ -0,0 +1,368 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraDefinitionSet.h"
+
+#include "FixedCameraSystem.h"
+#include "FixedCameraSubsystem.h"
+#include "FixedCameraActor.h"
+#include "FixedCameraPath.h"
+#include "Kismet/GameplayStatics.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/Paths.h"
+
+#pragma region UNREAL_ENGINE_EVENTS
+/// <summary>
+/// Sets default values for this actor's properties.
+/// </summary>
+AFixedCameraDefinitionSet::AFixedCameraDefinitionSet()
+{
+	// The view is updated by the camera manager, so the set never ticks.
+	PrimaryActorTick.bCanEverTick = false;
+
+	Root = CreateDefaultSubobject<USceneComponent>("Root Component");
+	RootComponent = Root;
+
+	CurrentZone = INDEX_NONE;
+	ActiveIndex = INDEX_NONE;
+	ActiveLocation = FVector::ZeroVector;
+	ActiveRotation = FRotator::ZeroRotator;
+	fBlendTime = 0.f;
+	fBlendDuration = 0.f;
+	fBlendExponent = 0.f;
+	BlendFunction = VTBlend_Linear;
+	PlayerCharacterActorReference = nullptr;
+}
+
+/// <summary>
+/// Called when the game starts or when spawned.
+/// </summary>
+void AFixedCameraDefinitionSet::BeginPlay()
+{
+	Super::BeginPlay();
+
+	PlayerCharacterActorReference = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+
+	if (NetworkFile.IsEmpty() || !LoadNetworkFile(NetworkFile))
+		BuildDefinitionIndices();
+
+	if (!DefaultCameraId.IsNone())
+		ActivateDefinition(DefaultCameraId);
+}
+
+/// <summary>
+/// Computes the view of the active definition.
+/// </summary>
+/// <param name="DeltaTime">Time between frames.</param>
+/// <param name="OutResult">View.</param>
+void AFixedCameraDefinitionSet::CalcCamera(float DeltaTime, FMinimalViewInfo& OutResult)
+{
+	if (!Definitions.IsValidIndex(ActiveIndex))
+	{
+		Super::CalcCamera(DeltaTime, OutResult);
+		return;
+	}
+
+	UpdateNetworkZone();
+	UpdateActiveView(DeltaTime);
+
+	OutResult.Location = ActiveLocation;
+	OutResult.Rotation = ActiveRotation;
+	OutResult.FOV = ActiveSettings.fFieldOfView;
+
+	// Blend between two definitions of this set (blends from other view targets are done by the camera manager).
+	if (fBlendTime < fBlendDuration)
+	{
+		fBlendTime += DeltaTime;
+
+		const float fAlpha = FMath::Clamp(fBlendTime / fBlendDuration, 0.f, 1.f);
+		float fWeight = fAlpha;
+		switch (BlendFunction)
+		{
+		case VTBlend_Cubic:
+			fWeight = FMath::CubicInterp(0.f, 0.f, 1.f, 0.f, fAlpha);
+			break;
+		case VTBlend_EaseIn:
+			fWeight = FMath::Pow(fAlpha, fBlendExponent);
+			break;
+		case VTBlend_EaseOut:
+			fWeight = FMath::Pow(fAlpha, 1.f / FMath::Max(fBlendExponent, KINDA_SMALL_NUMBER));
+			break;
+		case VTBlend_EaseInOut:
+			fWeight = FMath::InterpEaseInOut(0.f, 1.f, fAlpha, fBlendExponent);
+			break;
+		default:
+			break;
+		}
+
+		FMinimalViewInfo BlendedView = BlendFromView;
+		BlendedView.BlendViewInfo(OutResult, fWeight);
+		OutResult = BlendedView;
+	}
+
+	LastView = OutResult;
+}
+#pragma endregion
+
+#pragma region CLASS_EVENTS
+/// <summary>
+/// Makes a definition the view.
+/// </summary>
+/// <param name="CameraId">Definition identifier.</param>
+/// <param name="fSmoothTransition">Smoothness quantity.</param>
+/// <param name="BlendFunc">Smoothness type.</param>
+/// <param name="fBlendExp">Smoothness blend exponent.</param>
+/// <returns>False if no definition has this identifier.</returns>
+bool AFixedCameraDefinitionSet::ActivateDefinition(FName CameraId, float fSmoothTransition, TEnumAsByte<EViewTargetBlendFunction> BlendFunc, float fBlendExp)
+{
+	const int32* DefinitionIndex = DefinitionIndices.Find(CameraId);
+	return DefinitionIndex && ActivateDefinitionAt(*DefinitionIndex, fSmoothTransition, BlendFunc, fBlendExp);
+}
+
+/// <summary>
+/// Makes a definition the view.
+/// </summary>
+/// <param name="DefinitionIndex">Definition.</param>
+/// <param name="fSmoothTransition">Smoothness quantity.</param>
+/// <param name="BlendFunc">Smoothness type.</param>
+/// <param name="fBlendExp">Smoothness blend exponent.</param>
+/// <returns>False if there is no player controller.</returns>
+bool AFixedCameraDefinitionSet::ActivateDefinitionAt(int32 DefinitionIndex, float fSmoothTransition, TEnumAsByte<EViewTargetBlendFunction> BlendFunc, float fBlendExp)
+{
+	APlayerController* PlayerController = UGameplayStatics::GetPlayerController(this, 0);
+	if (!PlayerController)
+		return false;
+
+	const bool bIsViewTarget = PlayerController->GetViewTarget() == this;
+
+	// Only a switch inside the set needs its own blend.
+	fBlendTime = 0.f;
+	fBlendDuration = bIsViewTarget && Definitions.IsValidIndex(ActiveIndex) ? fSmoothTransition : 0.f;
+	fBlendExponent = fBlendExp;
+	BlendFunction = BlendFunc;
+	BlendFromView = LastView;
+
+	const FFixedCameraDefinition& Definition = Definitions[DefinitionIndex];
+	ActiveIndex = DefinitionIndex;
+
+	if (Definition.Profile)
+	{
+		Definition.Profile->GetSettings(ActiveSettings);
+	}
+	else
+	{
+		ActiveSettings = FFixedCameraSettings();
+		ActiveSettings.fFieldOfView = Definition.fFieldOfView;
+		ActiveSettings.CameraFocus = Definition.CameraFocus;
+	}
+
+	GetDefinitionTransform(Definition, ActiveLocation, ActiveRotation);
+	if (Definition.CameraRail)
+		ActiveLocation = Definition.CameraRail->GetInitialLocation();
+	else if (Definition.NetworkRail != INDEX_NONE)
+		ActiveLocation = GetActorTransform().TransformPosition(Network.GetLocationAlongRail(Definition.NetworkRail, 0.f));
+
+	if (!bIsViewTarget)
+	{
+		UFixedCameraSubsystem* FixedCameraSubsystem = GetWorld()->GetSubsystem<UFixedCameraSubsystem>();
+		AFixedCameraActor* ActiveCamera = FixedCameraSubsystem->GetActiveCamera();
+		if (ActiveCamera && PlayerController->GetViewTarget() == ActiveCamera)
+			ActiveCamera->DeactivateFixedCamera();
+
+		PlayerController->SetViewTargetWithBlend(this, fSmoothTransition, BlendFunc, fBlendExp);
+
+		// The set is not a fixed camera, so the subsystem stops working for the previous one.
+		FixedCameraSubsystem->NotifyCameraReleased();
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Returns the identifier of the active definition (none if no definition is active).
+/// </summary>
+FName AFixedCameraDefinitionSet::GetActiveCameraId() const
+{
+	return Definitions.IsValidIndex(ActiveIndex) ? Definitions[ActiveIndex].CameraId : NAME_None;
+}
+
+/// <summary>
+/// Returns the definition with this identifier, or null.
+/// </summary>
+/// <param name="CameraId">Definition identifier.</param>
+const FFixedCameraDefinition* AFixedCameraDefinitionSet::FindDefinition(FName CameraId) const
+{
+	const int32* DefinitionIndex = DefinitionIndices.Find(CameraId);
+	return DefinitionIndex ? &Definitions[*DefinitionIndex] : nullptr;
+}
+
+/// <summary>
+/// Replaces the definitions with the cameras of a network file.
+/// Packaged builds only contain the file if its directory is in DirectoriesToAlwaysStageAsNonUFS.
+/// </summary>
+/// <param name="FilePath">Network file, relative to the project content directory.</param>
+/// <returns>False if the file could not be loaded.</returns>
+bool AFixedCameraDefinitionSet::LoadNetworkFile(const FString& FilePath)
+{
+	FFixedCameraNetwork LoadedNetwork;
+	if (!LoadedNetwork.LoadFromFile(FPaths::Combine(FPaths::ProjectContentDir(), FilePath)))
+	{
+		UE_LOG(LogFixedCameraSystem, Error, TEXT("%s: camera network %s was not loaded, the definitions are kept. Packaged builds need its directory in DirectoriesToAlwaysStageAsNonUFS."), *GetName(), *FilePath);
+		return false;
+	}
+
+	LoadNetwork(MoveTemp(LoadedNetwork));
+	return true;
+}
+
+/// <summary>
+/// Replaces the definitions with the cameras of a network.
+/// </summary>
+/// <param name="InNetwork">Camera network, in the space of this actor.</param>
+void AFixedCameraDefinitionSet::LoadNetwork(FFixedCameraNetwork&& InNetwork)
+{
+	Network = MoveTemp(InNetwork);
+	CurrentZone = INDEX_NONE;
+	ActiveIndex = INDEX_NONE;
+
+	Definitions.Reset(Network.Cameras.Num());
+	for (const FFixedCameraNetworkCamera& Camera : Network.Cameras)
+	{
+		FFixedCameraDefinition& Definition = Definitions.AddDefaulted_GetRef();
+		Definition.CameraId = FName(*Network.Names[Camera.NameIndex]);
+		Definition.Location = FVector(Camera.Location[0], Camera.Location[1], Camera.Location[2]);
+		Definition.Rotation = FRotator(Camera.Rotation[0], Camera.Rotation[1], Camera.Rotation[2]);
+		Definition.fFieldOfView = Camera.fFieldOfView;
+		Definition.CameraFocus = (ECameraFocus)Camera.CameraFocus;
+		Definition.NetworkRail = Camera.RailIndex;
+	}
+
+	BuildDefinitionIndices();
+}
+
+/// <summary>
+/// Builds the definition index of each camera identifier.
+/// </summary>
+void AFixedCameraDefinitionSet::BuildDefinitionIndices()
+{
+	DefinitionIndices.Reset();
+	DefinitionIndices.Reserve(Definitions.Num());
+	for (int32 DefinitionIndex = 0; DefinitionIndex < Definitions.Num(); DefinitionIndex++)
+	{
+		const FName CameraId = Definitions[DefinitionIndex].CameraId;
+		if (DefinitionIndices.Contains(CameraId))
+		{
+			UE_LOG(LogFixedCameraSystem, Warning, TEXT("%s: camera definition %s is duplicated, only the first one is used."), *GetName(), *CameraId.ToString());
+			continue;
+		}
+
+		DefinitionIndices.Add(CameraId, DefinitionIndex);
+	}
+}
+
+/// <summary>
+/// Activates the camera of the network zone the player enters.
+/// </summary>
+void AFixedCameraDefinitionSet::UpdateNetworkZone()
+{
+	if (!PlayerCharacterActorReference || Network.Zones.Num() == 0)
+		return;
+
+	const FVector PlayerLocation = GetActorTransform().InverseTransformPosition(PlayerCharacterActorReference->GetActorLocation());
+	if (Network.Zones.IsValidIndex(CurrentZone) && Network.IsInZone(CurrentZone, PlayerLocation))
+		return;
+
+	// Only the neighbours of the current zone are tested, every zone if there is none.
+	if (Network.Zones.IsValidIndex(CurrentZone))
+	{
+		const FFixedCameraNetworkZone& Zone = Network.Zones[CurrentZone];
+		for (int32 TransitionIndex = Zone.FirstTransition; TransitionIndex < Zone.FirstTransition + Zone.NumTransitions; TransitionIndex++)
+		{
+			const FFixedCameraNetworkTransition& Transition = Network.Transitions[TransitionIndex];
+			if (!Network.IsInZone(Transition.TargetZone, PlayerLocation))
+				continue;
+
+			CurrentZone = Transition.TargetZone;
+			if (Network.Zones[CurrentZone].CameraIndex != ActiveIndex)
+				ActivateDefinitionAt(Network.Zones[CurrentZone].CameraIndex, Transition.fSmoothTransition, (EViewTargetBlendFunction)Transition.BlendFunc, Transition.fBlendExp);
+			return;
+		}
+	}
+
+	for (int32 ZoneIndex = 0; ZoneIndex < Network.Zones.Num(); ZoneIndex++)
+	{
+		if (ZoneIndex == CurrentZone || !Network.IsInZone(ZoneIndex, PlayerLocation))
+			continue;
+
+		CurrentZone = ZoneIndex;
+		if (Network.Zones[ZoneIndex].CameraIndex != ActiveIndex)
+			ActivateDefinitionAt(Network.Zones[ZoneIndex].CameraIndex, 0.f, VTBlend_Linear, 0.f);
+		return;
+	}
+}
+
+/// <summary>
+/// Moves and rotates the active definition towards the player.
+/// </summary>
+/// <param name="DeltaTime">Time between frames.</param>
+void AFixedCameraDefinitionSet::UpdateActiveView(float DeltaTime)
+{
+	// Find player in case that the reference is not set.
+	if (!PlayerCharacterActorReference)
+	{
+		PlayerCharacterActorReference = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+		return;
+	}
+
+	const FFixedCameraDefinition& Definition = Definitions[ActiveIndex];
+	const FVector PlayerLocation = PlayerCharacterActorReference->GetActorLocation();
+
+	// Calculate rail movement.
+	if (AFixedCameraPath* CameraRail = Definition.CameraRail)
+	{
+		const FVector RailLocation = CameraRail->GetLocationAlongRail(CameraRail->GetRailLength() * FMath::Clamp(FVector::Distance(PlayerLocation, ActiveLocation) / ActiveSettings.fRailTravellingDistance, 0.f, 1.f));
+		ActiveLocation = ActiveSettings.bSmoothMovement ? FMath::Lerp(ActiveLocation, RailLocation, DeltaTime * ActiveSettings.fSmoothMovementSpeed) : RailLocation;
+	}
+	else if (Definition.NetworkRail != INDEX_NONE)
+	{
+		const FTransform& ActorTransform = GetActorTransform();
+		const float fRailLength = Network.GetRailLength(Definition.NetworkRail);
+		const FVector RailLocation = ActorTransform.TransformPosition(Network.GetLocationAlongRail(Definition.NetworkRail, fRailLength * FMath::Clamp(FVector::Distance(PlayerLocation, ActiveLocation) / ActiveSettings.fRailTravellingDistance, 0.f, 1.f)));
+		ActiveLocation = ActiveSettings.bSmoothMovement ? FMath::Lerp(ActiveLocation, RailLocation, DeltaTime * ActiveSettings.fSmoothMovementSpeed) : RailLocation;
+	}
+
+	// Target and group focus need a camera actor.
+	FRotator TargetRotation;
+	switch (ActiveSettings.CameraFocus)
+	{
+	case ECameraFocus::FocusOnPlayer:
+		TargetRotation = UKismetMathLibrary::FindLookAtRotation(ActiveLocation, PlayerLocation);
+		break;
+	case ECameraFocus::MiddleLocationPlayerAndInitialFocus:
+	{
+		FVector InitialLocation;
+		FRotator InitialRotation;
+		GetDefinitionTransform(Definition, InitialLocation, InitialRotation);
+		TargetRotation = FRotator(FQuat::Slerp(FQuat(InitialRotation), FQuat(UKismetMathLibrary::FindLookAtRotation(ActiveLocation, PlayerLocation)), ActiveSettings.fMiddlePointAlpha));
+		break;
+	}
+	default:
+		return;
+	}
+
+	ActiveRotation = ActiveSettings.bSmoothRotation ? FMath::Lerp(ActiveRotation, TargetRotation, DeltaTime * ActiveSettings.fSmoothRotationSpeed) : TargetRotation;
+}
+
+/// <summary>
+/// Returns the world transform of a definition.
+/// </summary>
+/// <param name="Definition">Camera definition.</param>
+/// <param name="OutLocation">World location.</param>
+/// <param name="OutRotation">World rotation.</param>
+void AFixedCameraDefinitionSet::GetDefinitionTransform(const FFixedCameraDefinition& Definition, FVector& OutLocation, FRotator& OutRotation) const
+{
+	const FTransform& ActorTransform = GetActorTransform();
+	OutLocation = ActorTransform.TransformPosition(Definition.Location);
+	OutRotation = ActorTransform.TransformRotation(Definition.Rotation.Quaternion()).Rotator();
+}
+#pragma endregion
@@ -0,0 +1,247 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraDirector.h"
+
+#include "FixedCameraSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "Async/ParallelFor.h"
+
+#pragma region UNREAL_ENGINE_EVENTS
+/// <summary>
+/// Sets default values for this actor's properties.
+/// </summary>
+AFixedCameraDirector::AFixedCameraDirector()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PostPhysics;
+
+	Root = CreateDefaultSubobject<USceneComponent>("Root Component");
+	RootComponent = Root;
+
+	CurrentCamera = nullptr;
+	fShotTime = 0.f;
+	fEvaluationTime = 0.f;
+	PlayerCharacterActorReference = nullptr;
+}
+
+/// <summary>
+/// Called when the game starts or when spawned.
+/// </summary>
+void AFixedCameraDirector::BeginPlay()
+{
+	Super::BeginPlay();
+
+	PlayerCharacterActorReference = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+	CurrentCamera = GetWorld()->GetSubsystem<UFixedCameraSubsystem>()->GetActiveCamera();
+	fShotTime = 0.f;
+
+	// Evaluates on the first tick.
+	fEvaluationTime = fEvaluationInterval;
+}
+
+/// <summary>
+/// Called every frame.
+/// </summary>
+/// <param name="DeltaTime">Time between frames.</param>
+void AFixedCameraDirector::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Find player in case that the reference is not set.
+	if (!PlayerCharacterActorReference)
+	{
+		PlayerCharacterActorReference = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+		return;
+	}
+
+	ConsumeVisibilityTraces();
+
+	fShotTime += DeltaTime;
+	fEvaluationTime += DeltaTime;
+	if (fEvaluationTime < fEvaluationInterval)
+		return;
+
+	fEvaluationTime = 0.f;
+	Evaluate();
+	IssueVisibilityTraces();
+}
+#pragma endregion
+
+#pragma region CLASS_EVENTS
+/// <summary>
+/// Returns the camera chosen by the director.
+/// </summary>
+AFixedCameraActor* AFixedCameraDirector::GetCurrentCamera() const
+{
+	return CurrentCamera;
+}
+
+/// <summary>
+/// Stores the visibility traced last frame.
+/// </summary>
+void AFixedCameraDirector::ConsumeVisibilityTraces()
+{
+	if (PendingTraces.Num() == 0)
+		return;
+
+	TMap<TWeakObjectPtr<AFixedCameraActor>, int32> VisibleRays;
+	for (const TPair<TWeakObjectPtr<AFixedCameraActor>, FTraceHandle>& PendingTrace : PendingTraces)
+	{
+		FTraceDatum TraceDatum;
+		if (!PendingTrace.Key.IsValid() || !GetWorld()->QueryTraceData(PendingTrace.Value, TraceDatum))
+			continue;
+
+		int32& NumVisible = VisibleRays.FindOrAdd(PendingTrace.Key);
+		if (TraceDatum.OutHits.Num() == 0 || !TraceDatum.OutHits[0].bBlockingHit)
+			NumVisible++;
+	}
+	PendingTraces.Reset();
+
+	// Two rays per camera.
+	for (const TPair<TWeakObjectPtr<AFixedCameraActor>, int32>& Rays : VisibleRays)
+		CameraVisibility.Add(Rays.Key, Rays.Value * 0.5f);
+}
+
+/// <summary>
+/// Gathers the nearby candidates, scores them in parallel and cuts to the best one.
+/// </summary>
+void AFixedCameraDirector::Evaluate()
+{
+	UFixedCameraSubsystem* FixedCameraSubsystem = GetWorld()->GetSubsystem<UFixedCameraSubsystem>();
+
+	// Another switcher (e.g. a trigger) may have cut meanwhile.
+	if (FixedCameraSubsystem->GetActiveCamera() != CurrentCamera)
+	{
+		CurrentCamera = FixedCameraSubsystem->GetActiveCamera();
+		fShotTime = 0.f;
+	}
+
+	const FVector PlayerLocation = PlayerCharacterActorReference->GetActorLocation();
+	const FVector PlayerForward = PlayerCharacterActorReference->GetActorForwardVector();
+	const TArray<AFixedCameraActor*>& Cameras = CandidateCameras.Num() > 0 ? CandidateCameras : FixedCameraSubsystem->GetCameras();
+
+	// Snapshot the nearby cameras so the scoring does not touch any UObject.
+	Candidates.Reset();
+	for (AFixedCameraActor* Camera : Cameras)
+	{
+		if (!Camera || FVector::DistSquared(Camera->GetActorLocation(), PlayerLocation) > FMath::Square(fCandidateRadius))
+			continue;
+
+		const float* Visibility = CameraVisibility.Find(Camera);
+
+		FFixedCameraDirectorCandidate& Candidate = Candidates.AddDefaulted_GetRef();
+		Candidate.Camera = Camera;
+		Candidate.Location = Camera->Camera->GetComponentLocation();
+		Candidate.Forward = Camera->Camera->GetForwardVector();
+		Candidate.fHalfFOV = FMath::DegreesToRadians(Camera->Camera->FieldOfView * 0.5f);
+		Candidate.bTracksPlayer = Camera->GetCameraFocus() != ECameraFocus::NoFocus && Camera->GetCameraFocus() != ECameraFocus::FocusOnObject;
+		Candidate.fVisibility = Visibility ? *Visibility : 0.f;
+	}
+
+	Scores.SetNumUninitialized(Candidates.Num());
+	ParallelFor(Candidates.Num(), [this, &PlayerLocation, &PlayerForward](int32 CandidateIndex)
+	{
+		Scores[CandidateIndex] = ScoreCandidate(Candidates[CandidateIndex], PlayerLocation, PlayerForward);
+	});
+
+	// Best shot and score of the current one.
+	int32 BestCandidate = INDEX_NONE;
+	float fCurrentScore = 0.f;
+	for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); CandidateIndex++)
+	{
+		if (BestCandidate == INDEX_NONE || Scores[CandidateIndex] > Scores[BestCandidate])
+			BestCandidate = CandidateIndex;
+
+		if (Candidates[CandidateIndex].Camera == CurrentCamera)
+			fCurrentScore = Scores[CandidateIndex];
+	}
+
+	if (BestCandidate == INDEX_NONE || Scores[BestCandidate] <= 0.f || Candidates[BestCandidate].Camera == CurrentCamera)
+		return;
+
+	// Hysteresis: a cut needs a clear advantage and a minimum shot length, unless the player was lost.
+	const bool bPlayerLost = fCurrentScore <= 0.f;
+	if (!bPlayerLost && (fShotTime < fMinShotDuration || Scores[BestCandidate] < fCurrentScore + fSwitchMargin))
+		return;
+
+	SwitchToCamera(Candidates[BestCandidate].Camera);
+}
+
+/// <summary>
+/// Issues the visibility traces of the candidates, consumed next frame.
+/// </summary>
+void AFixedCameraDirector::IssueVisibilityTraces()
+{
+	const FVector PlayerLocation = PlayerCharacterActorReference->GetActorLocation();
+	const FVector HeadLocation = PlayerLocation + FVector(0.f, 0.f, fSubjectHeight * 0.5f);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FixedCameraDirector), false, PlayerCharacterActorReference);
+
+	for (const FFixedCameraDirectorCandidate& Candidate : Candidates)
+	{
+		QueryParams.ClearIgnoredActors();
+		QueryParams.AddIgnoredActor(PlayerCharacterActorReference);
+		QueryParams.AddIgnoredActor(Candidate.Camera);
+
+		PendingTraces.Emplace(Candidate.Camera, GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Test, Candidate.Location, PlayerLocation, ECC_Visibility, QueryParams));
+		PendingTraces.Emplace(Candidate.Camera, GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Test, Candidate.Location, HeadLocation, ECC_Visibility, QueryParams));
+	}
+}
+
+/// <summary>
+/// Scores a candidate view of the player (thread safe).
+/// </summary>
+/// <param name="Candidate">Candidate snapshot.</param>
+/// <param name="PlayerLocation">Player location.</param>
+/// <param name="PlayerForward">Player facing direction.</param>
+float AFixedCameraDirector::ScoreCandidate(const FFixedCameraDirectorCandidate& Candidate, const FVector& PlayerLocation, const FVector& PlayerForward) const
+{
+	const FVector ToPlayer = PlayerLocation - Candidate.Location;
+	const float Distance = ToPlayer.Size();
+
+	if (Candidate.fVisibility <= 0.f || Distance <= KINDA_SMALL_NUMBER)
+		return 0.f;
+
+	const FVector ToPlayerDirection = ToPlayer / Distance;
+
+	// Cameras that do not follow the player keep their rotation, so the player must be inside their view.
+	float CenterScore = 1.f;
+	if (!Candidate.bTracksPlayer)
+	{
+		const float Angle = FMath::Acos(FMath::Clamp(FVector::DotProduct(ToPlayerDirection, Candidate.Forward), -1.f, 1.f));
+		if (Angle > Candidate.fHalfFOV)
+			return 0.f;
+
+		CenterScore = 1.f - Angle / Candidate.fHalfFOV;
+	}
+
+	// Player facing the camera scores higher than seen from behind.
+	const float FacingScore = (1.f - FVector::DotProduct(ToPlayerDirection, PlayerForward)) * 0.5f;
+	const float AngleScore = (FacingScore + CenterScore) * 0.5f;
+
+	const float ScreenSize = fSubjectHeight / (Distance * FMath::Tan(Candidate.fHalfFOV));
+	const float ScreenSizeScore = FMath::Clamp(1.f - FMath::Abs(ScreenSize - fIdealScreenSize) / fIdealScreenSize, 0.f, 1.f);
+
+	return KINDA_SMALL_NUMBER + fVisibilityWeight * Candidate.fVisibility + fScreenSizeWeight * ScreenSizeScore + fAngleWeight * AngleScore;
+}
+
+/// <summary>
+/// Deactivates the current camera and activates a new one.
+/// </summary>
+/// <param name="NewCamera">Camera to cut to.</param>
+void AFixedCameraDirector::SwitchToCamera(AFixedCameraActor* NewCamera)
+{
+	const bool bFirstCamera = CurrentCamera == nullptr;
+
+	if (CurrentCamera)
+		CurrentCamera->DeactivateFixedCamera();
+
+	CurrentCamera = NewCamera;
+	fShotTime = 0.f;
+
+	if (bFirstCamera)
+		CurrentCamera->ActivateFixedCamera(0.f, VTBlend_Linear, 0.f);
+	else
+		CurrentCamera->ActivateFixedCamera(fSmoothTransition, BlendFunc, fBlendExp);
+}
+#pragma endregion
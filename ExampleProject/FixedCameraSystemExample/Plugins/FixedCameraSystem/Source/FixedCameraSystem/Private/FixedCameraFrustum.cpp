@@ -0,0 +1,185 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraFrustum.h"
+
+#include "FixedCameraVectorMath.h"
+#include "ConvexVolume.h"
+
+#pragma region CLASS_EVENTS
+/// <summary>
+/// Copies the planes of a convex volume.
+/// </summary>
+/// <param name="Volume">View frustum.</param>
+void FFixedCameraFrustum::Build(const FConvexVolume& Volume)
+{
+	PlaneX.Reset(Volume.Planes.Num());
+	PlaneY.Reset(Volume.Planes.Num());
+	PlaneZ.Reset(Volume.Planes.Num());
+	PlaneW.Reset(Volume.Planes.Num());
+
+	for (const FPlane& Plane : Volume.Planes)
+	{
+		PlaneX.Add((float)Plane.X);
+		PlaneY.Add((float)Plane.Y);
+		PlaneZ.Add((float)Plane.Z);
+		PlaneW.Add((float)Plane.W);
+	}
+}
+
+/// <summary>
+/// Returns true if the point is inside the frustum.
+/// </summary>
+/// <param name="Point">World location.</param>
+bool FFixedCameraFrustum::ContainsPoint(const FVector& Point) const
+{
+	return IntersectsSphere(Point, 0.f);
+}
+
+/// <summary>
+/// Returns true if the sphere intersects the frustum.
+/// </summary>
+/// <param name="Center">Sphere center.</param>
+/// <param name="Radius">Sphere radius.</param>
+bool FFixedCameraFrustum::IntersectsSphere(const FVector& Center, float Radius) const
+{
+	bool bInside = false;
+	IntersectsSpheres(MakeArrayView(&Center, 1), MakeArrayView(&Radius, 1), MakeArrayView(&bInside, 1));
+	return bInside;
+}
+
+/// <summary>
+/// Returns true if the box intersects the frustum.
+/// </summary>
+/// <param name="Box">World box.</param>
+bool FFixedCameraFrustum::IntersectsBox(const FBox& Box) const
+{
+	bool bInside = false;
+	IntersectsBoxes(MakeArrayView(&Box, 1), MakeArrayView(&bInside, 1));
+	return bInside;
+}
+
+/// <summary>
+/// Writes whether each point is inside the frustum.
+/// </summary>
+/// <param name="Points">World locations.</param>
+/// <param name="OutInside">Result per point. Must have the same size as Points.</param>
+void FFixedCameraFrustum::ContainsPoints(TArrayView<const FVector> Points, TArrayView<bool> OutInside) const
+{
+	check(Points.Num() == OutInside.Num());
+
+	alignas(16) float X[4], Y[4], Z[4];
+	alignas(16) const float Zero[4] = { 0.f, 0.f, 0.f, 0.f };
+
+	for (int32 First = 0; First < Points.Num(); First += 4)
+	{
+		const int32 NumLanes = FMath::Min(4, Points.Num() - First);
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			// Unused lanes repeat the last point.
+			const FVector& Point = Points[First + FMath::Min(Lane, NumLanes - 1)];
+			X[Lane] = (float)Point.X;
+			Y[Lane] = (float)Point.Y;
+			Z[Lane] = (float)Point.Z;
+		}
+
+		const int32 OutsideMask = TestLanes(X, Y, Z, Zero, Zero, Zero, Zero);
+		for (int32 Lane = 0; Lane < NumLanes; Lane++)
+			OutInside[First + Lane] = (OutsideMask & (1 << Lane)) == 0;
+	}
+}
+
+/// <summary>
+/// Writes whether each sphere intersects the frustum.
+/// </summary>
+/// <param name="Centers">Sphere centers.</param>
+/// <param name="Radii">Sphere radii. Must have the same size as Centers.</param>
+/// <param name="OutInside">Result per sphere. Must have the same size as Centers.</param>
+void FFixedCameraFrustum::IntersectsSpheres(TArrayView<const FVector> Centers, TArrayView<const float> Radii, TArrayView<bool> OutInside) const
+{
+	check(Centers.Num() == Radii.Num() && Centers.Num() == OutInside.Num());
+
+	alignas(16) float X[4], Y[4], Z[4], R[4];
+	alignas(16) const float Zero[4] = { 0.f, 0.f, 0.f, 0.f };
+
+	for (int32 First = 0; First < Centers.Num(); First += 4)
+	{
+		const int32 NumLanes = FMath::Min(4, Centers.Num() - First);
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			const int32 Index = First + FMath::Min(Lane, NumLanes - 1);
+			X[Lane] = (float)Centers[Index].X;
+			Y[Lane] = (float)Centers[Index].Y;
+			Z[Lane] = (float)Centers[Index].Z;
+			R[Lane] = Radii[Index];
+		}
+
+		const int32 OutsideMask = TestLanes(X, Y, Z, R, Zero, Zero, Zero);
+		for (int32 Lane = 0; Lane < NumLanes; Lane++)
+			OutInside[First + Lane] = (OutsideMask & (1 << Lane)) == 0;
+	}
+}
+
+/// <summary>
+/// Writes whether each box intersects the frustum.
+/// </summary>
+/// <param name="Boxes">World boxes.</param>
+/// <param name="OutInside">Result per box. Must have the same size as Boxes.</param>
+void FFixedCameraFrustum::IntersectsBoxes(TArrayView<const FBox> Boxes, TArrayView<bool> OutInside) const
+{
+	check(Boxes.Num() == OutInside.Num());
+
+	alignas(16) float X[4], Y[4], Z[4], EX[4], EY[4], EZ[4];
+	alignas(16) const float Zero[4] = { 0.f, 0.f, 0.f, 0.f };
+
+	for (int32 First = 0; First < Boxes.Num(); First += 4)
+	{
+		const int32 NumLanes = FMath::Min(4, Boxes.Num() - First);
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			FVector Center, Extent;
+			Boxes[First + FMath::Min(Lane, NumLanes - 1)].GetCenterAndExtents(Center, Extent);
+			X[Lane] = (float)Center.X;
+			Y[Lane] = (float)Center.Y;
+			Z[Lane] = (float)Center.Z;
+			EX[Lane] = (float)Extent.X;
+			EY[Lane] = (float)Extent.Y;
+			EZ[Lane] = (float)Extent.Z;
+		}
+
+		const int32 OutsideMask = TestLanes(X, Y, Z, Zero, EX, EY, EZ);
+		for (int32 Lane = 0; Lane < NumLanes; Lane++)
+			OutInside[First + Lane] = (OutsideMask & (1 << Lane)) == 0;
+	}
+}
+
+/// <summary>
+/// Returns a bit per lane whose sphere (or box of the given extents) is outside any plane.
+/// </summary>
+int32 FFixedCameraFrustum::TestLanes(const float* X, const float* Y, const float* Z, const float* R, const float* EX, const float* EY, const float* EZ) const
+{
+	const FFixedCameraVectorRegister LaneX = VectorLoadAligned(X);
+	const FFixedCameraVectorRegister LaneY = VectorLoadAligned(Y);
+	const FFixedCameraVectorRegister LaneZ = VectorLoadAligned(Z);
+	const FFixedCameraVectorRegister LaneR = VectorLoadAligned(R);
+	const FFixedCameraVectorRegister LaneEX = VectorLoadAligned(EX);
+	const FFixedCameraVectorRegister LaneEY = VectorLoadAligned(EY);
+	const FFixedCameraVectorRegister LaneEZ = VectorLoadAligned(EZ);
+
+	FFixedCameraVectorRegister Outside = VectorZero();
+
+	for (int32 PlaneIndex = 0; PlaneIndex < PlaneX.Num(); PlaneIndex++)
+	{
+		const FFixedCameraVectorRegister NX = VectorSetFloat1(PlaneX[PlaneIndex]);
+		const FFixedCameraVectorRegister NY = VectorSetFloat1(PlaneY[PlaneIndex]);
+		const FFixedCameraVectorRegister NZ = VectorSetFloat1(PlaneZ[PlaneIndex]);
+
+		// Signed distance of the centers, and the box extents projected on the plane normal.
+		const FFixedCameraVectorRegister Distance = VectorSubtract(VectorMultiplyAdd(NX, LaneX, VectorMultiplyAdd(NY, LaneY, VectorMultiply(NZ, LaneZ))), VectorSetFloat1(PlaneW[PlaneIndex]));
+		const FFixedCameraVectorRegister PushOut = VectorMultiplyAdd(VectorAbs(NX), LaneEX, VectorMultiplyAdd(VectorAbs(NY), LaneEY, VectorMultiplyAdd(VectorAbs(NZ), LaneEZ, LaneR)));
+
+		Outside = VectorBitwiseOr(Outside, VectorCompareGT(Distance, PushOut));
+	}
+
+	return VectorMaskBits(Outside);
+}
+#pragma endregion
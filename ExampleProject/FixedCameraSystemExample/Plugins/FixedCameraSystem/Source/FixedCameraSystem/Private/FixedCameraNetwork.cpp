@@ -0,0 +1,339 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraNetwork.h"
+
+#include "FixedCameraSystem.h"
+#include "FixedCameraProfile.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/FileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Serialization/LargeMemoryReader.h"
+#include "Algo/BinarySearch.h"
+
+namespace FixedCameraNetwork
+{
+	/// <summary>
+	/// First bytes of every network file ("FCNW").
+	/// </summary>
+	static const uint32 Magic = 0x574E4346;
+
+	/// <summary>
+	/// Bulk serializes a record array, checking its count against the remaining bytes before anything is allocated.
+	/// </summary>
+	/// <param name="Ar">Archive.</param>
+	/// <param name="Records">Record array.</param>
+	template<typename RecordType>
+	static void SerializeRecords(FArchive& Ar, TArray<RecordType>& Records)
+	{
+		if (Ar.IsError())
+			return;
+
+		if (Ar.IsLoading())
+		{
+			const int64 ArrayStart = Ar.Tell();
+			int32 ElementSize = 0;
+			int32 NumRecords = 0;
+			Ar << ElementSize << NumRecords;
+
+			if (Ar.IsError() || ElementSize != sizeof(RecordType) || NumRecords < 0 || (int64)NumRecords * ElementSize > Ar.TotalSize() - Ar.Tell())
+			{
+				Ar.SetError();
+				return;
+			}
+
+			Ar.Seek(ArrayStart);
+		}
+
+		Records.BulkSerialize(Ar);
+	}
+
+	/// <summary>
+	/// Serializes the names, checking their count against the remaining bytes (each name stores at least its length).
+	/// </summary>
+	/// <param name="Ar">Archive.</param>
+	/// <param name="Names">Names.</param>
+	static void SerializeNames(FArchive& Ar, TArray<FString>& Names)
+	{
+		if (Ar.IsError())
+			return;
+
+		if (Ar.IsLoading())
+		{
+			const int64 ArrayStart = Ar.Tell();
+			int32 NumNames = 0;
+			Ar << NumNames;
+
+			if (Ar.IsError() || NumNames < 0 || (int64)NumNames * sizeof(int32) > Ar.TotalSize() - Ar.Tell())
+			{
+				Ar.SetError();
+				return;
+			}
+
+			Ar.Seek(ArrayStart);
+		}
+
+		Ar << Names;
+	}
+}
+
+#pragma region CLASS_EVENTS
+FArchive& operator<<(FArchive& Ar, FFixedCameraNetworkCamera& Camera)
+{
+	Ar << Camera.NameIndex;
+	Ar << Camera.Location[0] << Camera.Location[1] << Camera.Location[2];
+	Ar << Camera.Rotation[0] << Camera.Rotation[1] << Camera.Rotation[2];
+	Ar << Camera.fFieldOfView << Camera.RailIndex << Camera.CameraFocus;
+
+	// Padding is written as zeros, so the same network always gives the same file.
+	if (Ar.IsSaving())
+		FMemory::Memzero(Camera.Padding);
+
+	Ar << Camera.Padding[0] << Camera.Padding[1] << Camera.Padding[2];
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FFixedCameraNetworkRail& Rail)
+{
+	return Ar << Rail.FirstPoint << Rail.NumPoints;
+}
+
+FArchive& operator<<(FArchive& Ar, FFixedCameraNetworkPoint& Point)
+{
+	return Ar << Point.X << Point.Y << Point.Z;
+}
+
+FArchive& operator<<(FArchive& Ar, FFixedCameraNetworkZone& Zone)
+{
+	Ar << Zone.NameIndex << Zone.CameraIndex;
+	Ar << Zone.Center[0] << Zone.Center[1] << Zone.Center[2] << Zone.fYaw;
+	Ar << Zone.Extent[0] << Zone.Extent[1] << Zone.Extent[2];
+	Ar << Zone.FirstTransition << Zone.NumTransitions;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FFixedCameraNetworkTransition& Transition)
+{
+	Ar << Transition.TargetZone << Transition.fSmoothTransition << Transition.fBlendExp << Transition.BlendFunc;
+
+	if (Ar.IsSaving())
+		FMemory::Memzero(Transition.Padding);
+
+	Ar << Transition.Padding[0] << Transition.Padding[1] << Transition.Padding[2];
+	return Ar;
+}
+
+/// <summary>
+/// Reads or writes the network.
+/// </summary>
+/// <param name="Ar">Archive.</param>
+/// <returns>False if the data is not a valid network.</returns>
+bool FFixedCameraNetwork::Serialize(FArchive& Ar)
+{
+	uint32 Magic = FixedCameraNetwork::Magic;
+	uint32 Version = (uint32)EFixedCameraNetworkVersion::LatestVersion;
+	Ar << Magic << Version;
+
+	if (Ar.IsLoading() && (Magic != FixedCameraNetwork::Magic || Version == 0 || Version > (uint32)EFixedCameraNetworkVersion::LatestVersion))
+	{
+		UE_LOG(LogFixedCameraSystem, Error, TEXT("%s is not a camera network of a supported version."), *Ar.GetArchiveName());
+		Reset();
+		return false;
+	}
+
+	FixedCameraNetwork::SerializeNames(Ar, Names);
+	FixedCameraNetwork::SerializeRecords(Ar, Cameras);
+	FixedCameraNetwork::SerializeRecords(Ar, Rails);
+	FixedCameraNetwork::SerializeRecords(Ar, RailPoints);
+	FixedCameraNetwork::SerializeRecords(Ar, Zones);
+	FixedCameraNetwork::SerializeRecords(Ar, Transitions);
+
+	if (Ar.IsLoading())
+	{
+		if (Ar.IsError() || !Validate())
+		{
+			UE_LOG(LogFixedCameraSystem, Error, TEXT("%s is a corrupted camera network."), *Ar.GetArchiveName());
+			Reset();
+			return false;
+		}
+
+		BuildRailDistances();
+	}
+
+	return !Ar.IsError();
+}
+
+/// <summary>
+/// Reads a network file, memory-mapped if the platform allows it or streamed otherwise.
+/// </summary>
+/// <param name="FilePath">Network file.</param>
+/// <returns>False if the file could not be read or is not a valid network.</returns>
+bool FFixedCameraNetwork::LoadFromFile(const FString& FilePath)
+{
+	const double fStartTime = FPlatformTime::Seconds();
+	bool bLoaded = false;
+
+	TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile ? MappedFile->MapRegion() : nullptr);
+
+	if (MappedRegion)
+	{
+		FLargeMemoryReader Reader(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize(), ELargeMemoryReaderFlags::None, FName(*FilePath));
+		bLoaded = Serialize(Reader);
+	}
+	else
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+		if (!Reader)
+		{
+			UE_LOG(LogFixedCameraSystem, Error, TEXT("Camera network %s could not be opened."), *FilePath);
+			return false;
+		}
+
+		bLoaded = Serialize(*Reader);
+		Reader->Close();
+	}
+
+	// The region must be unmapped before its file.
+	MappedRegion.Reset();
+	MappedFile.Reset();
+
+	if (bLoaded)
+	{
+		UE_LOG(LogFixedCameraSystem, Log, TEXT("Camera network %s loaded: %d cameras, %d rails, %d zones (%.2f ms)."),
+			*FilePath, Cameras.Num(), Rails.Num(), Zones.Num(), (FPlatformTime::Seconds() - fStartTime) * 1000.0);
+	}
+
+	return bLoaded;
+}
+
+/// <summary>
+/// Writes the network to a file.
+/// </summary>
+/// <param name="FilePath">Network file.</param>
+/// <returns>False if the file could not be written.</returns>
+bool FFixedCameraNetwork::SaveToFile(const FString& FilePath)
+{
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Writer)
+		return false;
+
+	Serialize(*Writer);
+	return Writer->Close();
+}
+
+/// <summary>
+/// Removes every record.
+/// </summary>
+void FFixedCameraNetwork::Reset()
+{
+	Names.Reset();
+	Cameras.Reset();
+	Rails.Reset();
+	RailPoints.Reset();
+	RailPointDistances.Reset();
+	Zones.Reset();
+	Transitions.Reset();
+}
+
+/// <summary>
+/// Returns the length of a rail.
+/// </summary>
+/// <param name="RailIndex">Rail.</param>
+float FFixedCameraNetwork::GetRailLength(int32 RailIndex) const
+{
+	if (!Rails.IsValidIndex(RailIndex))
+		return 0.f;
+
+	const FFixedCameraNetworkRail& Rail = Rails[RailIndex];
+	return RailPointDistances[Rail.FirstPoint + Rail.NumPoints - 1];
+}
+
+/// <summary>
+/// Returns the location at a distance along a rail.
+/// </summary>
+/// <param name="RailIndex">Rail.</param>
+/// <param name="fDistance">Distance from the first point.</param>
+FVector FFixedCameraNetwork::GetLocationAlongRail(int32 RailIndex, float fDistance) const
+{
+	if (!Rails.IsValidIndex(RailIndex))
+		return FVector::ZeroVector;
+
+	const FFixedCameraNetworkRail& Rail = Rails[RailIndex];
+	const TArrayView<const float> Distances(&RailPointDistances[Rail.FirstPoint], Rail.NumPoints);
+
+	// Segment containing the distance.
+	const int32 Segment = FMath::Clamp(Algo::UpperBound(Distances, fDistance) - 1, 0, Rail.NumPoints - 2);
+	const FFixedCameraNetworkPoint& Start = RailPoints[Rail.FirstPoint + Segment];
+	const FFixedCameraNetworkPoint& End = RailPoints[Rail.FirstPoint + Segment + 1];
+
+	const float fSegmentLength = Distances[Segment + 1] - Distances[Segment];
+	const float fAlpha = fSegmentLength > KINDA_SMALL_NUMBER ? FMath::Clamp((fDistance - Distances[Segment]) / fSegmentLength, 0.f, 1.f) : 0.f;
+
+	return FMath::Lerp(FVector(Start.X, Start.Y, Start.Z), FVector(End.X, End.Y, End.Z), fAlpha);
+}
+
+/// <summary>
+/// Returns true if the location is inside a zone.
+/// </summary>
+/// <param name="ZoneIndex">Zone.</param>
+/// <param name="Location">Location, in the space of the network.</param>
+bool FFixedCameraNetwork::IsInZone(int32 ZoneIndex, const FVector& Location) const
+{
+	const FFixedCameraNetworkZone& Zone = Zones[ZoneIndex];
+	const FVector Local = FRotator(0.f, -Zone.fYaw, 0.f).RotateVector(Location - FVector(Zone.Center[0], Zone.Center[1], Zone.Center[2]));
+
+	return FMath::Abs(Local.X) <= Zone.Extent[0] && FMath::Abs(Local.Y) <= Zone.Extent[1] && FMath::Abs(Local.Z) <= Zone.Extent[2];
+}
+
+/// <summary>
+/// Checks that every index references an existing record.
+/// </summary>
+bool FFixedCameraNetwork::Validate() const
+{
+	for (const FFixedCameraNetworkCamera& Camera : Cameras)
+	{
+		if (!Names.IsValidIndex(Camera.NameIndex) || (Camera.RailIndex != INDEX_NONE && !Rails.IsValidIndex(Camera.RailIndex))
+			|| Camera.CameraFocus > (uint8)ECameraFocus::FocusOnGroup)
+			return false;
+	}
+
+	for (const FFixedCameraNetworkRail& Rail : Rails)
+	{
+		if (Rail.NumPoints < 2 || Rail.FirstPoint < 0 || Rail.FirstPoint + Rail.NumPoints > RailPoints.Num())
+			return false;
+	}
+
+	for (const FFixedCameraNetworkZone& Zone : Zones)
+	{
+		if (!Names.IsValidIndex(Zone.NameIndex) || !Cameras.IsValidIndex(Zone.CameraIndex)
+			|| Zone.NumTransitions < 0 || Zone.FirstTransition < 0 || Zone.FirstTransition + Zone.NumTransitions > Transitions.Num())
+			return false;
+	}
+
+	for (const FFixedCameraNetworkTransition& Transition : Transitions)
+	{
+		if (!Zones.IsValidIndex(Transition.TargetZone))
+			return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Computes the accumulated distances of the rail points.
+/// </summary>
+void FFixedCameraNetwork::BuildRailDistances()
+{
+	RailPointDistances.SetNumZeroed(RailPoints.Num());
+
+	for (const FFixedCameraNetworkRail& Rail : Rails)
+	{
+		for (int32 Point = Rail.FirstPoint + 1; Point < Rail.FirstPoint + Rail.NumPoints; Point++)
+		{
+			const FFixedCameraNetworkPoint& Previous = RailPoints[Point - 1];
+			const FFixedCameraNetworkPoint& Current = RailPoints[Point];
+			RailPointDistances[Point] = RailPointDistances[Point - 1] + FVector::Distance(FVector(Previous.X, Previous.Y, Previous.Z), FVector(Current.X, Current.Y, Current.Z));
+		}
+	}
+}
+#pragma endregion
@@ -0,0 +1,308 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraPool.h"
+
+#include "FixedCameraSystem.h"
+#include "FixedCameraActor.h"
+#include "FixedCameraPath.h"
+#include "FixedCameraTrigger.h"
+#include "FixedCameraSubsystem.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/PlayerController.h"
+
+#pragma region CLASS_EVENTS
+/// <summary>
+/// Places the cameras, rails and triggers of a room, recycling released actors first.
+/// Every camera is registered before the triggers are enabled.
+/// </summary>
+/// <param name="Room">Room description.</param>
+/// <param name="RoomTransform">Room world transform.</param>
+/// <returns>Room identifier (0 if the room is not valid).</returns>
+int32 UFixedCameraPoolSubsystem::SpawnRoom(const FFixedCameraRoomDescription& Room, const FTransform& RoomTransform)
+{
+	UWorld* World = GetWorld();
+	if (!World || !World->IsGameWorld())
+		return 0;
+
+	for (const FFixedCameraRoomCamera& RoomCamera : Room.Cameras)
+	{
+		if (RoomCamera.RailIndex != INDEX_NONE && !Room.Rails.IsValidIndex(RoomCamera.RailIndex))
+		{
+			UE_LOG(LogFixedCameraSystem, Warning, TEXT("Room camera %s references rail %d, which does not exist."), *RoomCamera.CameraId.ToString(), RoomCamera.RailIndex);
+			return 0;
+		}
+	}
+
+	for (const FFixedCameraRoomRail& RoomRail : Room.Rails)
+	{
+		if (RoomRail.Points.Num() < 2)
+		{
+			UE_LOG(LogFixedCameraSystem, Warning, TEXT("Room rails need at least two points."));
+			return 0;
+		}
+	}
+
+	for (const FFixedCameraRoomTrigger& RoomTrigger : Room.Triggers)
+	{
+		if ((RoomTrigger.Camera1 != INDEX_NONE && !Room.Cameras.IsValidIndex(RoomTrigger.Camera1)) || (RoomTrigger.Camera2 != INDEX_NONE && !Room.Cameras.IsValidIndex(RoomTrigger.Camera2)))
+		{
+			UE_LOG(LogFixedCameraSystem, Warning, TEXT("Room trigger references a camera that does not exist."));
+			return 0;
+		}
+	}
+
+	const double fStartTime = FPlatformTime::Seconds();
+	UFixedCameraSubsystem* FixedCameraSubsystem = World->GetSubsystem<UFixedCameraSubsystem>();
+	int32 NumRecycled = 0;
+
+	const int32 RoomId = NextRoomId++;
+	FFixedCameraPooledRoom& PooledRoom = Rooms.Add(RoomId);
+	PooledRoom.Cameras.Reserve(Room.Cameras.Num());
+	PooledRoom.Rails.Reserve(Room.Rails.Num());
+	PooledRoom.Triggers.Reserve(Room.Triggers.Num());
+
+	// Rails first, cameras are placed at the start of their rail.
+	for (const FFixedCameraRoomRail& RoomRail : Room.Rails)
+	{
+		AFixedCameraPath* Rail = PopFree(FreeRails);
+		if (Rail)
+		{
+			Rail->SetActorTransform(RoomTransform);
+			NumRecycled++;
+		}
+		else
+		{
+			FActorSpawnParameters SpawnParameters;
+			SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			Rail = World->SpawnActor<AFixedCameraPath>(AFixedCameraPath::StaticClass(), RoomTransform, SpawnParameters);
+		}
+
+		Rail->CameraPath->SetSplinePoints(RoomRail.Points, ESplineCoordinateSpace::Local);
+		PooledRoom.Rails.Add(Rail);
+	}
+
+	// New cameras are configured before BeginPlay, so they register with their room identifier.
+	for (const FFixedCameraRoomCamera& RoomCamera : Room.Cameras)
+	{
+		const FTransform CameraTransform = FTransform(RoomCamera.Rotation, RoomCamera.Location) * RoomTransform;
+
+		AFixedCameraActor* Camera = PopFree(FreeCameras);
+		const bool bRecycled = Camera != nullptr;
+		if (!bRecycled)
+			Camera = World->SpawnActorDeferred<AFixedCameraActor>(AFixedCameraActor::StaticClass(), CameraTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+
+		Camera->CameraId = RoomCamera.CameraId;
+		Camera->Profile = RoomCamera.Profile;
+		Camera->Tags = RoomCamera.Tags;
+		Camera->CameraType = RoomCamera.RailIndex != INDEX_NONE ? ECameraType::Rail : ECameraType::Static;
+		Camera->CameraRail = RoomCamera.RailIndex != INDEX_NONE ? PooledRoom.Rails[RoomCamera.RailIndex] : nullptr;
+
+		if (bRecycled)
+		{
+			Camera->SetActorTransform(CameraTransform);
+			Camera->ResetFixedCamera();
+			FixedCameraSubsystem->RegisterCamera(Camera);
+			NumRecycled++;
+		}
+		else
+		{
+			Camera->FinishSpawning(CameraTransform);
+		}
+
+		PooledRoom.Cameras.Add(Camera);
+	}
+
+	// Triggers last, a trigger may switch cameras as soon as its collision is enabled.
+	for (const FFixedCameraRoomTrigger& RoomTrigger : Room.Triggers)
+	{
+		const FTransform TriggerTransform = FTransform(RoomTrigger.Rotation, RoomTrigger.Location, FVector(1.f, RoomTrigger.Scale.X, RoomTrigger.Scale.Y)) * RoomTransform;
+
+		AFixedCameraTrigger* Trigger = PopFree(FreeTriggers);
+		const bool bRecycled = Trigger != nullptr;
+		if (!bRecycled)
+			Trigger = World->SpawnActorDeferred<AFixedCameraTrigger>(AFixedCameraTrigger::StaticClass(), TriggerTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+
+		Trigger->Camera1 = RoomTrigger.Camera1 != INDEX_NONE ? PooledRoom.Cameras[RoomTrigger.Camera1] : nullptr;
+		Trigger->fSmoothTransition1 = RoomTrigger.fSmoothTransition1;
+		Trigger->BlendFunc1 = RoomTrigger.BlendFunc1;
+		Trigger->fBlendExp1 = RoomTrigger.fBlendExp1;
+		Trigger->Camera2 = RoomTrigger.Camera2 != INDEX_NONE ? PooledRoom.Cameras[RoomTrigger.Camera2] : nullptr;
+		Trigger->fSmoothTransition2 = RoomTrigger.fSmoothTransition2;
+		Trigger->BlendFunc2 = RoomTrigger.BlendFunc2;
+		Trigger->fBlendExp2 = RoomTrigger.fBlendExp2;
+		Trigger->bEvaluateOnAsyncPhysicsTick = RoomTrigger.bEvaluateOnAsyncPhysicsTick;
+
+		if (bRecycled)
+		{
+			Trigger->SetActorTransform(TriggerTransform);
+			Trigger->ResetTrigger();
+			Trigger->SetActorEnableCollision(true);
+			FixedCameraSubsystem->RegisterTrigger(Trigger);
+			NumRecycled++;
+		}
+		else
+		{
+			Trigger->FinishSpawning(TriggerTransform);
+		}
+
+		PooledRoom.Triggers.Add(Trigger);
+	}
+
+	UE_LOG(LogFixedCameraSystem, Verbose, TEXT("Room %d placed: %d cameras, %d rails, %d triggers, %d recycled actors (%.2f ms)."),
+		RoomId, Room.Cameras.Num(), Room.Rails.Num(), Room.Triggers.Num(), NumRecycled, (FPlatformTime::Seconds() - fStartTime) * 1000.0);
+
+	return RoomId;
+}
+
+/// <summary>
+/// Unregisters and disables the actors of a room and returns them to the pool.
+/// A room whose camera is the active camera or the view target is kept, the view must move to another camera first.
+/// </summary>
+/// <param name="RoomId">Room identifier.</param>
+/// <returns>False if the room does not exist or one of its cameras is in view.</returns>
+bool UFixedCameraPoolSubsystem::ReleaseRoom(int32 RoomId)
+{
+	const FFixedCameraPooledRoom* RoomToRelease = Rooms.Find(RoomId);
+	if (!RoomToRelease)
+		return false;
+
+	// A parked camera would stay the view target, so the player would keep looking through it.
+	const UFixedCameraSubsystem* FixedCameraSubsystem = GetWorld()->GetSubsystem<UFixedCameraSubsystem>();
+	const AFixedCameraActor* ActiveCamera = FixedCameraSubsystem ? FixedCameraSubsystem->GetActiveCamera() : nullptr;
+	const APlayerController* PlayerController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
+	const AActor* ViewTarget = PlayerController ? PlayerController->GetViewTarget() : nullptr;
+
+	for (const AFixedCameraActor* Camera : RoomToRelease->Cameras)
+	{
+		if (Camera && (Camera == ActiveCamera || Camera == ViewTarget))
+		{
+			UE_LOG(LogFixedCameraSystem, Warning, TEXT("Room %d is not released, its camera %s is in view."), RoomId, *Camera->GetName());
+			return false;
+		}
+	}
+
+	FFixedCameraPooledRoom PooledRoom;
+	Rooms.RemoveAndCopyValue(RoomId, PooledRoom);
+
+	// Triggers first, so no camera of the room is activated while it is released.
+	for (AFixedCameraTrigger* Trigger : PooledRoom.Triggers)
+	{
+		if (IsValid(Trigger))
+			ReleaseTrigger(Trigger);
+	}
+
+	for (AFixedCameraActor* Camera : PooledRoom.Cameras)
+	{
+		if (IsValid(Camera))
+			ReleaseCamera(Camera);
+	}
+
+	for (AFixedCameraPath* Rail : PooledRoom.Rails)
+	{
+		if (IsValid(Rail))
+			FreeRails.Add(Rail);
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Returns the cameras of a room, in the order of its description.
+/// </summary>
+/// <param name="RoomId">Room identifier.</param>
+/// <param name="OutCameras">Room cameras.</param>
+void UFixedCameraPoolSubsystem::GetRoomCameras(int32 RoomId, TArray<AFixedCameraActor*>& OutCameras) const
+{
+	const FFixedCameraPooledRoom* PooledRoom = Rooms.Find(RoomId);
+	if (PooledRoom)
+		OutCameras = PooledRoom->Cameras;
+	else
+		OutCameras.Reset();
+}
+
+/// <summary>
+/// Spawns pooled actors ahead of time, so rooms can be placed without spawning.
+/// </summary>
+/// <param name="NumCameras">Cameras to add to the pool.</param>
+/// <param name="NumRails">Rails to add to the pool.</param>
+/// <param name="NumTriggers">Triggers to add to the pool.</param>
+void UFixedCameraPoolSubsystem::Prewarm(int32 NumCameras, int32 NumRails, int32 NumTriggers)
+{
+	UWorld* World = GetWorld();
+	if (!World || !World->IsGameWorld())
+		return;
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	for (int32 Index = 0; Index < NumCameras; Index++)
+		ReleaseCamera(World->SpawnActor<AFixedCameraActor>(AFixedCameraActor::StaticClass(), FTransform::Identity, SpawnParameters));
+
+	for (int32 Index = 0; Index < NumRails; Index++)
+		FreeRails.Add(World->SpawnActor<AFixedCameraPath>(AFixedCameraPath::StaticClass(), FTransform::Identity, SpawnParameters));
+
+	for (int32 Index = 0; Index < NumTriggers; Index++)
+		ReleaseTrigger(World->SpawnActor<AFixedCameraTrigger>(AFixedCameraTrigger::StaticClass(), FTransform::Identity, SpawnParameters));
+}
+
+/// <summary>
+/// Returns a released actor, or null if the pool is empty.
+/// </summary>
+/// <param name="FreeActors">Released actors of a class.</param>
+template<typename ActorType>
+ActorType* UFixedCameraPoolSubsystem::PopFree(TArray<ActorType*>& FreeActors)
+{
+	// Pooled actors are destroyed with their level.
+	while (FreeActors.Num() > 0)
+	{
+		ActorType* Actor = FreeActors.Pop();
+		if (IsValid(Actor))
+			return Actor;
+	}
+
+	return nullptr;
+}
+
+/// <summary>
+/// Unregisters and disables a camera.
+/// </summary>
+/// <param name="Camera">Fixed camera.</param>
+void UFixedCameraPoolSubsystem::ReleaseCamera(AFixedCameraActor* Camera)
+{
+	// Unregistered before the identifier and tags are cleared, so the lookups are updated.
+	if (UFixedCameraSubsystem* FixedCameraSubsystem = GetWorld()->GetSubsystem<UFixedCameraSubsystem>())
+		FixedCameraSubsystem->UnregisterCamera(Camera);
+
+	Camera->SetActorTickEnabled(false);
+	Camera->Camera->SetActive(false);
+	Camera->SetStreamingSourceEnabled(false);
+
+	Camera->CameraId = NAME_None;
+	Camera->Tags.Reset();
+	Camera->CameraRail = nullptr;
+	Camera->FocusTarget = nullptr;
+	Camera->FocusGroup.Reset();
+
+	FreeCameras.Add(Camera);
+}
+
+/// <summary>
+/// Unregisters and disables a trigger.
+/// </summary>
+/// <param name="Trigger">Fixed camera trigger.</param>
+void UFixedCameraPoolSubsystem::ReleaseTrigger(AFixedCameraTrigger* Trigger)
+{
+	// Cleared first, disabling the collision ends the overlaps and would switch cameras.
+	Trigger->Camera1 = nullptr;
+	Trigger->Camera2 = nullptr;
+
+	Trigger->StopTrigger();
+	Trigger->SetActorEnableCollision(false);
+
+	if (UFixedCameraSubsystem* FixedCameraSubsystem = GetWorld()->GetSubsystem<UFixedCameraSubsystem>())
+		FixedCameraSubsystem->UnregisterTrigger(Trigger);
+
+	FreeTriggers.Add(Trigger);
+}
+#pragma endregion
@@ -0,0 +1,131 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraSignificanceComponent.h"
+
+#include "FixedCameraSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Actor.h"
+
+#pragma region UNREAL_ENGINE_EVENTS
+/// <summary>
+/// Sets default values for this component's properties.
+/// </summary>
+UFixedCameraSignificanceComponent::UFixedCameraSignificanceComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	Significance = EFixedCameraSignificance::Visible;
+	fOriginalActorTickInterval = 0.f;
+}
+
+/// <summary>
+/// Called when the game starts.
+/// </summary>
+void UFixedCameraSignificanceComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	GetWorld()->GetSubsystem<UFixedCameraSubsystem>()->RegisterSignificanceComponent(this);
+}
+
+/// <summary>
+/// Called when the component is removed from play.
+/// </summary>
+/// <param name="EndPlayReason">End play reason.</param>
+void UFixedCameraSignificanceComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UFixedCameraSubsystem* FixedCameraSubsystem = GetWorld()->GetSubsystem<UFixedCameraSubsystem>())
+		FixedCameraSubsystem->UnregisterSignificanceComponent(this);
+
+	SetSignificance(EFixedCameraSignificance::Visible);
+
+	Super::EndPlay(EndPlayReason);
+}
+#pragma endregion
+
+#pragma region CLASS_EVENTS
+/// <summary>
+/// Returns the current significance.
+/// </summary>
+EFixedCameraSignificance UFixedCameraSignificanceComponent::GetSignificance() const
+{
+	return Significance;
+}
+
+/// <summary>
+/// Applies a new significance to the owner (called by the fixed camera subsystem).
+/// </summary>
+/// <param name="NewSignificance">New significance.</param>
+void UFixedCameraSignificanceComponent::SetSignificance(EFixedCameraSignificance NewSignificance)
+{
+	if (NewSignificance == Significance)
+		return;
+
+	const bool bWasSignificant = Significance != EFixedCameraSignificance::Insignificant;
+	const bool bSignificant = NewSignificance != EFixedCameraSignificance::Insignificant;
+	Significance = NewSignificance;
+
+	AActor* Owner = GetOwner();
+
+	if (Owner && bWasSignificant && !bSignificant)
+	{
+		// Reduce tick rates, enable URO and suspend cloth.
+		fOriginalActorTickInterval = Owner->GetActorTickInterval();
+		Owner->SetActorTickInterval(FMath::Max(fOriginalActorTickInterval, fInsignificantTickInterval));
+
+		TInlineComponentArray<UActorComponent*> Components(Owner);
+		for (UActorComponent* Component : Components)
+		{
+			if (Component == this)
+				continue;
+
+			OriginalComponentTickIntervals.Add(Component, Component->GetComponentTickInterval());
+			Component->SetComponentTickInterval(FMath::Max(Component->GetComponentTickInterval(), fInsignificantTickInterval));
+
+			if (USkeletalMeshComponent* Mesh = Cast<USkeletalMeshComponent>(Component))
+			{
+				if (bUseUpdateRateOptimizations)
+				{
+					OriginalUpdateRateOptimizations.Add(Mesh, Mesh->bEnableUpdateRateOptimizations);
+					Mesh->bEnableUpdateRateOptimizations = true;
+				}
+
+				if (bSuspendCloth && !Mesh->IsClothingSimulationSuspended())
+				{
+					Mesh->SuspendClothingSimulation();
+					SuspendedClothMeshes.Add(Mesh);
+				}
+			}
+		}
+	}
+	else if (Owner && !bWasSignificant && bSignificant)
+	{
+		// Restore everything.
+		Owner->SetActorTickInterval(fOriginalActorTickInterval);
+
+		for (const TPair<TWeakObjectPtr<UActorComponent>, float>& Pair : OriginalComponentTickIntervals)
+		{
+			if (Pair.Key.IsValid())
+				Pair.Key->SetComponentTickInterval(Pair.Value);
+		}
+
+		for (const TPair<TWeakObjectPtr<UActorComponent>, bool>& Pair : OriginalUpdateRateOptimizations)
+		{
+			if (USkeletalMeshComponent* Mesh = Cast<USkeletalMeshComponent>(Pair.Key.Get()))
+				Mesh->bEnableUpdateRateOptimizations = Pair.Value;
+		}
+
+		for (const TWeakObjectPtr<USkeletalMeshComponent>& Mesh : SuspendedClothMeshes)
+		{
+			if (Mesh.IsValid())
+				Mesh->ResumeClothingSimulation();
+		}
+
+		OriginalComponentTickIntervals.Reset();
+		OriginalUpdateRateOptimizations.Reset();
+		SuspendedClothMeshes.Reset();
+	}
+
+	OnSignificanceChanged.Broadcast(Significance);
+}
+#pragma endregion
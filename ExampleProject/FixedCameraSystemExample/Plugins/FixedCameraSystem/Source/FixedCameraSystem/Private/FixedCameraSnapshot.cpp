@@ -0,0 +1,117 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraSnapshot.h"
+
+#include "FixedCameraSystem.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Misc/Crc.h"
+
+#pragma region CLASS_EVENTS
+FArchive& operator<<(FArchive& Ar, FFixedCameraSnapshotCamera& Camera)
+{
+	Ar << Camera.CameraIdHash << Camera.Flags << Camera.RailProgress;
+	Ar << Camera.Rotation[0] << Camera.Rotation[1] << Camera.Rotation[2];
+	Ar << Camera.FieldOfView;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FFixedCameraSnapshotBlend& Blend)
+{
+	return Ar << Blend.fBlendTime << Blend.fBlendTimeToGo << Blend.fBlendExp << Blend.BlendFunc;
+}
+
+FArchive& operator<<(FArchive& Ar, FFixedCameraSnapshotZone& Zone)
+{
+	return Ar << Zone.ZoneGraphHash << Zone.Zone;
+}
+
+/// <summary>
+/// Writes the records into the data.
+/// </summary>
+void FFixedCameraSnapshot::Pack()
+{
+	Data.Reset();
+	FMemoryWriter Writer(Data);
+
+	uint8 Version = (uint8)EFixedCameraSnapshotVersion::LatestVersion;
+	uint8 NumCameras = (uint8)FMath::Min(Cameras.Num(), 255);
+	uint8 NumZones = (uint8)FMath::Min(Zones.Num(), 255);
+	uint8 bBlend = bHasBlend ? 1 : 0;
+
+	Writer << Version << NumCameras;
+	for (int32 Index = 0; Index < NumCameras; Index++)
+		Writer << Cameras[Index];
+
+	Writer << bBlend;
+	if (bBlend)
+		Writer << Blend;
+
+	Writer << NumZones;
+	for (int32 Index = 0; Index < NumZones; Index++)
+		Writer << Zones[Index];
+}
+
+/// <summary>
+/// Reads the records from the data.
+/// </summary>
+/// <returns>False if the data is not a valid snapshot.</returns>
+bool FFixedCameraSnapshot::Unpack()
+{
+	Cameras.Reset();
+	Zones.Reset();
+	bHasBlend = false;
+
+	if (Data.Num() == 0)
+		return false;
+
+	FMemoryReader Reader(Data);
+
+	uint8 Version = 0;
+	Reader << Version;
+	if (Version == 0 || Version > (uint8)EFixedCameraSnapshotVersion::LatestVersion)
+	{
+		UE_LOG(LogFixedCameraSystem, Warning, TEXT("Camera snapshot version %d is not supported."), Version);
+		return false;
+	}
+
+	uint8 NumCameras = 0;
+	Reader << NumCameras;
+	Cameras.SetNumUninitialized(NumCameras);
+	for (FFixedCameraSnapshotCamera& Camera : Cameras)
+		Reader << Camera;
+
+	uint8 bBlend = 0;
+	Reader << bBlend;
+	bHasBlend = bBlend != 0;
+	if (bHasBlend)
+		Reader << Blend;
+
+	uint8 NumZones = 0;
+	Reader << NumZones;
+	Zones.SetNumUninitialized(NumZones);
+	for (FFixedCameraSnapshotZone& Zone : Zones)
+		Reader << Zone;
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogFixedCameraSystem, Warning, TEXT("Camera snapshot is corrupted."));
+		Cameras.Reset();
+		Zones.Reset();
+		bHasBlend = false;
+		return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Returns the hash stored for a camera identifier or an actor name.
+/// </summary>
+/// <param name="Name">Identifier.</param>
+uint32 FFixedCameraSnapshot::HashName(FName Name)
+{
+	// Names compare case-insensitively, and their indices change between runs.
+	return FCrc::StrCrc32(*Name.ToString().ToLower());
+}
+#pragma endregion
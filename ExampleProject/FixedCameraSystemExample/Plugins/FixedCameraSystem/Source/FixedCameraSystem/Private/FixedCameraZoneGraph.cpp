@@ -0,0 +1,480 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraZoneGraph.h"
+
+#include "FixedCameraSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "DrawDebugHelpers.h"
+#include "Math/ConvexHull2d.h"
+
+#pragma region UNREAL_ENGINE_EVENTS
+/// <summary>
+/// Sets default values for this actor's properties.
+/// </summary>
+AFixedCameraZoneGraph::AFixedCameraZoneGraph()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PostPhysics;
+
+	Root = CreateDefaultSubobject<USceneComponent>("Root Component");
+	RootComponent = Root;
+
+	CurrentZone = INDEX_NONE;
+	PlayerCharacterActorReference = nullptr;
+}
+
+/// <summary>
+/// Called when the game starts or when spawned.
+/// </summary>
+void AFixedCameraZoneGraph::BeginPlay()
+{
+	Super::BeginPlay();
+
+	CurrentZone = INDEX_NONE;
+	PlayerCharacterActorReference = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+
+	RebuildZoneHulls();
+
+	GetWorld()->GetSubsystem<UFixedCameraSubsystem>()->RegisterZoneGraph(this);
+}
+
+/// <summary>
+/// Called when the actor is removed from the level.
+/// </summary>
+/// <param name="EndPlayReason">End play reason.</param>
+void AFixedCameraZoneGraph::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UFixedCameraSubsystem* FixedCameraSubsystem = GetWorld()->GetSubsystem<UFixedCameraSubsystem>())
+		FixedCameraSubsystem->UnregisterZoneGraph(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+/// <summary>
+/// Called every frame.
+/// </summary>
+/// <param name="DeltaTime">Time between frames.</param>
+void AFixedCameraZoneGraph::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!GetWorld()->IsGameWorld())
+	{
+		if (bShowZones)
+			DrawZones();
+		return;
+	}
+
+	// Find player in case that the reference is not set.
+	if (!PlayerCharacterActorReference)
+	{
+		PlayerCharacterActorReference = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+		return;
+	}
+
+	const FVector PlayerLocation = PlayerCharacterActorReference->GetActorLocation();
+
+	// First frame: search every zone.
+	if (CurrentZone == INDEX_NONE)
+	{
+		const int32 NewZone = FindZone(PlayerLocation);
+		if (NewZone != INDEX_NONE)
+			EnterZone(NewZone, nullptr);
+		return;
+	}
+
+	// Nothing to do while the player stays inside the current zone.
+	if (IsInZone(CurrentZone, PlayerLocation))
+	{
+		return;
+	}
+
+	// Only the neighbours of the current zone are tested.
+	for (const FFixedCameraZoneTransition& Transition : Zones[CurrentZone].Transitions)
+	{
+		if (IsInZone(Transition.TargetZone, PlayerLocation))
+		{
+			EnterZone(Transition.TargetZone, &Transition);
+			return;
+		}
+	}
+
+	if (bFullSearchFallback)
+	{
+		const int32 NewZone = FindZone(PlayerLocation);
+		if (NewZone != INDEX_NONE)
+			EnterZone(NewZone, nullptr);
+	}
+}
+
+/// <summary>
+/// Ticks in the Editor viewport to draw the zones.
+/// </summary>
+bool AFixedCameraZoneGraph::ShouldTickIfViewportsOnly() const
+{
+	return bShowZones;
+}
+#pragma endregion
+
+#pragma region CLASS_EVENTS
+/// <summary>
+/// Returns the index of the zone the player is in.
+/// </summary>
+int32 AFixedCameraZoneGraph::GetCurrentZone() const
+{
+	return CurrentZone;
+}
+
+/// <summary>
+/// Sets the zone the player is in without switching cameras (used to restore a snapshot).
+/// </summary>
+/// <param name="ZoneIndex">Zone index.</param>
+void AFixedCameraZoneGraph::SetCurrentZone(int32 ZoneIndex)
+{
+	CurrentZone = Zones.IsValidIndex(ZoneIndex) ? ZoneIndex : INDEX_NONE;
+}
+
+/// <summary>
+/// Returns true if the location is inside the zone.
+/// </summary>
+/// <param name="ZoneIndex">Zone index.</param>
+/// <param name="Location">World location.</param>
+bool AFixedCameraZoneGraph::IsInZone(int32 ZoneIndex, const FVector& Location) const
+{
+	return ZoneHulls.IsInZone(ZoneIndex, Location);
+}
+
+/// <summary>
+/// Returns the first zone containing the location, testing every zone.
+/// </summary>
+/// <param name="Location">World location.</param>
+int32 AFixedCameraZoneGraph::FindZone(const FVector& Location) const
+{
+	return ZoneHulls.FindZone(Location);
+}
+
+/// <summary>
+/// Returns the zones whose camera is the given one.
+/// </summary>
+/// <param name="Camera">Fixed camera.</param>
+/// <param name="OutZones">Zone indices.</param>
+void AFixedCameraZoneGraph::GetCameraZones(const AFixedCameraActor* Camera, TArray<int32>& OutZones) const
+{
+	OutZones.Reset();
+
+	for (int32 ZoneIndex = 0; ZoneIndex < Zones.Num(); ZoneIndex++)
+	{
+		if (Zones[ZoneIndex].Camera == Camera)
+			OutZones.Add(ZoneIndex);
+	}
+}
+
+/// <summary>
+/// Adds the cameras of the zones adjacent to the zones of a camera.
+/// </summary>
+/// <param name="Camera">Fixed camera.</param>
+/// <param name="OutCameras">Adjacent cameras (appended, unique).</param>
+void AFixedCameraZoneGraph::GetAdjacentCameras(const AFixedCameraActor* Camera, TArray<AFixedCameraActor*>& OutCameras) const
+{
+	for (const FFixedCameraZone& Zone : Zones)
+	{
+		if (Zone.Camera != Camera)
+			continue;
+
+		for (const FFixedCameraZoneTransition& Transition : Zone.Transitions)
+		{
+			if (Zones.IsValidIndex(Transition.TargetZone) && Zones[Transition.TargetZone].Camera && Zones[Transition.TargetZone].Camera != Camera)
+				OutCameras.AddUnique(Zones[Transition.TargetZone].Camera);
+		}
+	}
+}
+
+/// <summary>
+/// Returns the zone of each location in a single vectorized pass.
+/// </summary>
+/// <param name="Locations">World locations.</param>
+/// <param name="OutZones">Zone per location (INDEX_NONE if outside every zone).</param>
+void AFixedCameraZoneGraph::FindZonesBatch(const TArray<FVector>& Locations, TArray<int32>& OutZones) const
+{
+	OutZones.SetNumUninitialized(Locations.Num());
+	ZoneHulls.FindZones(Locations, OutZones);
+}
+
+/// <summary>
+/// Updates the zone of each tracked agent and the zone occupancy counts. Keep InOutZones between calls, only the agents that changed zone modify the counts.
+/// </summary>
+/// <param name="Locations">Agent world locations.</param>
+/// <param name="InOutZones">Zone of each agent on the previous call, updated with the new zones.</param>
+void AFixedCameraZoneGraph::UpdateZoneOccupancy(const TArray<FVector>& Locations, TArray<int32>& InOutZones)
+{
+	if (ZoneOccupancy.Num() != Zones.Num())
+		ZoneOccupancy.SetNumZeroed(Zones.Num());
+
+	// Agents removed since the previous call leave their zones.
+	for (int32 AgentIndex = Locations.Num(); AgentIndex < InOutZones.Num(); AgentIndex++)
+	{
+		if (ZoneOccupancy.IsValidIndex(InOutZones[AgentIndex]))
+			ZoneOccupancy[InOutZones[AgentIndex]]--;
+	}
+
+	const int32 NumPreviousAgents = FMath::Min(InOutZones.Num(), Locations.Num());
+
+	TArray<int32> NewZones;
+	FindZonesBatch(Locations, NewZones);
+
+	for (int32 AgentIndex = 0; AgentIndex < NewZones.Num(); AgentIndex++)
+	{
+		const int32 PreviousZone = AgentIndex < NumPreviousAgents ? InOutZones[AgentIndex] : INDEX_NONE;
+		if (PreviousZone == NewZones[AgentIndex])
+			continue;
+
+		if (ZoneOccupancy.IsValidIndex(PreviousZone))
+			ZoneOccupancy[PreviousZone]--;
+		if (ZoneOccupancy.IsValidIndex(NewZones[AgentIndex]))
+			ZoneOccupancy[NewZones[AgentIndex]]++;
+	}
+
+	InOutZones = MoveTemp(NewZones);
+}
+
+/// <summary>
+/// Returns the number of tracked agents inside a zone.
+/// </summary>
+/// <param name="ZoneIndex">Zone index.</param>
+int32 AFixedCameraZoneGraph::GetZoneOccupancy(int32 ZoneIndex) const
+{
+	return ZoneOccupancy.IsValidIndex(ZoneIndex) ? ZoneOccupancy[ZoneIndex] : 0;
+}
+
+/// <summary>
+/// Removes the agents of a tracker from the occupancy counts and clears its zones, so that its next update starts from scratch.
+/// </summary>
+/// <param name="InOutZones">Zone of each agent of the tracker, emptied.</param>
+void AFixedCameraZoneGraph::ResetZoneOccupancy(TArray<int32>& InOutZones)
+{
+	if (ZoneOccupancy.Num() != Zones.Num())
+		ZoneOccupancy.SetNumZeroed(Zones.Num());
+
+	// Only this tracker's agents leave their zones, other trackers keep their counts in sync.
+	for (const int32 Zone : InOutZones)
+	{
+		if (ZoneOccupancy.IsValidIndex(Zone))
+			ZoneOccupancy[Zone] = FMath::Max(ZoneOccupancy[Zone] - 1, 0);
+	}
+
+	InOutZones.Reset();
+}
+
+/// <summary>
+/// Rebuilds the zone half-planes. Call it after moving the graph, its zones or their splines at runtime.
+/// </summary>
+void AFixedCameraZoneGraph::RebuildZoneHulls()
+{
+	ZoneHulls.Reset();
+
+	TArray<TArray<FPlane>> Hulls;
+	for (int32 ZoneIndex = 0; ZoneIndex < Zones.Num(); ZoneIndex++)
+	{
+		GetZoneHullPlanes(ZoneIndex, Hulls);
+		for (const TArray<FPlane>& Hull : Hulls)
+			ZoneHulls.AddHull(ZoneIndex, Hull);
+	}
+
+	ZoneHulls.Finalize(Zones.Num());
+}
+
+/// <summary>
+/// Returns the world space half-planes of each convex piece of a zone.
+/// </summary>
+/// <param name="ZoneIndex">Zone index.</param>
+/// <param name="OutHulls">Convex pieces.</param>
+void AFixedCameraZoneGraph::GetZoneHullPlanes(int32 ZoneIndex, TArray<TArray<FPlane>>& OutHulls) const
+{
+	OutHulls.Reset();
+
+	if (!Zones.IsValidIndex(ZoneIndex))
+		return;
+
+	const FFixedCameraZone& Zone = Zones[ZoneIndex];
+
+	if (Zone.Shape == EFixedCameraZoneShape::Convex)
+	{
+		TArray<FVector> HullPoints;
+		GetConvexHullPoints(Zone, HullPoints);
+		if (HullPoints.Num() < 3)
+			return;
+
+		FVector Centroid = FVector::ZeroVector;
+		for (const FVector& Point : HullPoints)
+			Centroid += Point;
+		Centroid /= HullPoints.Num();
+
+		// Side planes are built in zone space and then transformed to world space.
+		const FMatrix ZoneToWorld = (Zone.ZoneTransform * GetActorTransform()).ToMatrixWithScale();
+		TArray<FPlane>& Planes = OutHulls.AddDefaulted_GetRef();
+
+		for (int32 PointIndex = 0; PointIndex < HullPoints.Num(); PointIndex++)
+		{
+			const FVector& A = HullPoints[PointIndex];
+			const FVector& B = HullPoints[(PointIndex + 1) % HullPoints.Num()];
+
+			FVector Normal = FVector(B.Y - A.Y, A.X - B.X, 0.f).GetSafeNormal();
+			if (FVector::DotProduct(Normal, Centroid - A) > 0.f)
+				Normal = -Normal;
+
+			Planes.Add(FPlane(A, Normal).TransformBy(ZoneToWorld));
+		}
+
+		Planes.Add(FPlane(0.f, 0.f, 1.f, Zone.ZoneExtent.Z).TransformBy(ZoneToWorld));
+		Planes.Add(FPlane(0.f, 0.f, -1.f, Zone.ZoneExtent.Z).TransformBy(ZoneToWorld));
+		return;
+	}
+
+	TArray<FTransform> Boxes;
+	GetZoneBoxes(Zone, Boxes);
+
+	for (const FTransform& Box : Boxes)
+	{
+		TArray<FPlane>& Planes = OutHulls.AddDefaulted_GetRef();
+		const FVector Center = Box.GetLocation();
+		const FVector Extent = Box.GetScale3D();
+		const FVector Axes[3] = { Box.GetUnitAxis(EAxis::X), Box.GetUnitAxis(EAxis::Y), Box.GetUnitAxis(EAxis::Z) };
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			const float AxisCenter = FVector::DotProduct(Axes[Axis], Center);
+			Planes.Add(FPlane(Axes[Axis], AxisCenter + Extent[Axis]));
+			Planes.Add(FPlane(-Axes[Axis], -AxisCenter + Extent[Axis]));
+		}
+	}
+}
+
+/// <summary>
+/// Returns the world space oriented boxes of a box or spline extrusion zone.
+/// </summary>
+/// <param name="Zone">Zone.</param>
+/// <param name="OutBoxes">Box transforms (scale is the half size).</param>
+void AFixedCameraZoneGraph::GetZoneBoxes(const FFixedCameraZone& Zone, TArray<FTransform>& OutBoxes) const
+{
+	OutBoxes.Reset();
+
+	if (Zone.Shape == EFixedCameraZoneShape::Box)
+	{
+		const FTransform ZoneWorldTransform = Zone.ZoneTransform * GetActorTransform();
+		OutBoxes.Add(FTransform(ZoneWorldTransform.GetRotation(), ZoneWorldTransform.GetLocation(), Zone.ZoneExtent * ZoneWorldTransform.GetScale3D()));
+		return;
+	}
+
+	if (Zone.Shape != EFixedCameraZoneShape::SplineExtrusion || !Zone.ExtrusionPath)
+		return;
+
+	// One box per segment. Segments are lengthened by the half width so they overlap on bends.
+	const USplineComponent* Spline = Zone.ExtrusionPath->CameraPath;
+	const float Length = Spline->GetSplineLength();
+	const int32 NumSegments = FMath::Max(1, FMath::CeilToInt(Length / Zone.fExtrusionSegmentLength));
+
+	for (int32 Segment = 0; Segment < NumSegments; Segment++)
+	{
+		const FVector Start = Spline->GetLocationAtDistanceAlongSpline(Length * Segment / NumSegments, ESplineCoordinateSpace::World);
+		const FVector End = Spline->GetLocationAtDistanceAlongSpline(Length * (Segment + 1) / NumSegments, ESplineCoordinateSpace::World);
+		const FVector Up = Spline->GetUpVectorAtDistanceAlongSpline(Length * (Segment + 0.5f) / NumSegments, ESplineCoordinateSpace::World);
+
+		const FQuat Rotation = FRotationMatrix::MakeFromXZ(End - Start, Up).ToQuat();
+		const FVector Extent((End - Start).Size() * 0.5f + Zone.ZoneExtent.Y, Zone.ZoneExtent.Y, Zone.ZoneExtent.Z);
+
+		OutBoxes.Add(FTransform(Rotation, (Start + End) * 0.5f, Extent));
+	}
+}
+
+/// <summary>
+/// Returns the convex prism base points of a zone, in order, relative to the zone transform.
+/// </summary>
+/// <param name="Zone">Zone.</param>
+/// <param name="OutPoints">Hull points.</param>
+void AFixedCameraZoneGraph::GetConvexHullPoints(const FFixedCameraZone& Zone, TArray<FVector>& OutPoints)
+{
+	OutPoints.Reset();
+
+	TArray<FVector> FlatPoints;
+	for (const FVector& Point : Zone.ConvexPoints)
+		FlatPoints.Add(FVector(Point.X, Point.Y, 0.f));
+
+	TArray<int32> HullIndices;
+	ConvexHull2D::ComputeConvexHull(FlatPoints, HullIndices);
+
+	for (int32 PointIndex : HullIndices)
+		OutPoints.Add(FlatPoints[PointIndex]);
+}
+
+/// <summary>
+/// Switches from the active camera to the new zone camera.
+/// </summary>
+/// <param name="NewZone">Zone entered by the player.</param>
+/// <param name="Transition">Blend settings, nullptr for a cut.</param>
+void AFixedCameraZoneGraph::EnterZone(int32 NewZone, const FFixedCameraZoneTransition* Transition)
+{
+	AFixedCameraActor* NewCamera = Zones[NewZone].Camera;
+	const int32 PreviousZone = CurrentZone;
+
+	CurrentZone = NewZone;
+
+	UFixedCameraSubsystem* FixedCameraSubsystem = GetWorld()->GetSubsystem<UFixedCameraSubsystem>();
+	if (FixedCameraSubsystem)
+		FixedCameraSubsystem->NotifyZoneChanged(this, PreviousZone, NewZone);
+
+	// The active camera can come from the default camera, a trigger or the director, not only from the previous zone.
+	AFixedCameraActor* PreviousCamera = FixedCameraSubsystem ? FixedCameraSubsystem->GetActiveCamera() : nullptr;
+
+	if (!NewCamera || NewCamera == PreviousCamera)
+		return;
+
+	if (PreviousCamera)
+		PreviousCamera->DeactivateFixedCamera();
+
+	if (Transition)
+		NewCamera->ActivateFixedCamera(Transition->fSmoothTransition, Transition->BlendFunc, Transition->fBlendExp);
+	else
+		NewCamera->ActivateFixedCamera(0.f, VTBlend_Linear, 0.f);
+}
+
+/// <summary>
+/// Draws the zones and the transitions between them.
+/// </summary>
+void AFixedCameraZoneGraph::DrawZones() const
+{
+	TArray<FTransform> Boxes;
+	TArray<FVector> HullPoints;
+
+	for (const FFixedCameraZone& Zone : Zones)
+	{
+		const FTransform ZoneWorldTransform = Zone.ZoneTransform * GetActorTransform();
+
+		if (Zone.Shape == EFixedCameraZoneShape::Convex)
+		{
+			GetConvexHullPoints(Zone, HullPoints);
+			for (int32 PointIndex = 0; PointIndex < HullPoints.Num(); PointIndex++)
+			{
+				const FVector A = HullPoints[PointIndex];
+				const FVector B = HullPoints[(PointIndex + 1) % HullPoints.Num()];
+				const FVector Height(0.f, 0.f, Zone.ZoneExtent.Z);
+
+				DrawDebugLine(GetWorld(), ZoneWorldTransform.TransformPosition(A + Height), ZoneWorldTransform.TransformPosition(B + Height), FColor::Orange, false, -1.f, 0, 2.f);
+				DrawDebugLine(GetWorld(), ZoneWorldTransform.TransformPosition(A - Height), ZoneWorldTransform.TransformPosition(B - Height), FColor::Orange, false, -1.f, 0, 2.f);
+				DrawDebugLine(GetWorld(), ZoneWorldTransform.TransformPosition(A + Height), ZoneWorldTransform.TransformPosition(A - Height), FColor::Orange, false, -1.f, 0, 2.f);
+			}
+		}
+		else
+		{
+			GetZoneBoxes(Zone, Boxes);
+			for (const FTransform& Box : Boxes)
+				DrawDebugBox(GetWorld(), Box.GetLocation(), Box.GetScale3D(), Box.GetRotation(), FColor::Orange, false, -1.f, 0, 2.f);
+		}
+
+		for (const FFixedCameraZoneTransition& Transition : Zone.Transitions)
+		{
+			if (Zones.IsValidIndex(Transition.TargetZone))
+				DrawDebugDirectionalArrow(GetWorld(), ZoneWorldTransform.GetLocation(), (Zones[Transition.TargetZone].ZoneTransform * GetActorTransform()).GetLocation(), 50.f, FColor::Cyan, false, -1.f, 0, 2.f);
+		}
+	}
+}
+#pragma endregion
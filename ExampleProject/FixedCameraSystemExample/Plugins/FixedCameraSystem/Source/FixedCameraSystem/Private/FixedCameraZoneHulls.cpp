@@ -0,0 +1,248 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraZoneHulls.h"
+
+#include "FixedCameraVectorMath.h"
+
+#pragma region CLASS_EVENTS
+/// <summary>
+/// Removes every hull.
+/// </summary>
+void FFixedCameraZoneHulls::Reset()
+{
+	PendingHulls.Reset();
+	HullZones.Reset();
+	ZoneHullStart.Reset();
+	ZoneHullCount.Reset();
+	GroupPlaneStart.Reset();
+	GroupPlaneCount.Reset();
+	PlaneX.Reset();
+	PlaneY.Reset();
+	PlaneZ.Reset();
+	PlaneW.Reset();
+}
+
+/// <summary>
+/// Adds a convex hull to a zone. The inside is where Plane.PlaneDot(Location) is not positive.
+/// </summary>
+/// <param name="ZoneIndex">Owner zone.</param>
+/// <param name="Planes">World space half-planes.</param>
+void FFixedCameraZoneHulls::AddHull(int32 ZoneIndex, const TArray<FPlane>& Planes)
+{
+	if (ZoneIndex < 0 || Planes.Num() == 0)
+		return;
+
+	PendingHulls.Emplace(ZoneIndex, Planes);
+}
+
+/// <summary>
+/// Packs the added hulls for the vectorized tests. Must be called after the last AddHull.
+/// </summary>
+/// <param name="NumZones">Number of zones.</param>
+void FFixedCameraZoneHulls::Finalize(int32 NumZones)
+{
+	// Sort hulls by zone so the hulls of a zone are contiguous.
+	PendingHulls.StableSort([](const TPair<int32, TArray<FPlane>>& A, const TPair<int32, TArray<FPlane>>& B) { return A.Key < B.Key; });
+	PendingHulls.RemoveAll([NumZones](const TPair<int32, TArray<FPlane>>& Hull) { return Hull.Key >= NumZones; });
+
+	HullZones.Reset(PendingHulls.Num());
+	ZoneHullStart.Init(0, NumZones);
+	ZoneHullCount.Init(0, NumZones);
+
+	for (int32 HullIndex = 0; HullIndex < PendingHulls.Num(); HullIndex++)
+	{
+		const int32 ZoneIndex = PendingHulls[HullIndex].Key;
+		if (ZoneHullCount[ZoneIndex] == 0)
+			ZoneHullStart[ZoneIndex] = HullIndex;
+		ZoneHullCount[ZoneIndex]++;
+		HullZones.Add(ZoneIndex);
+	}
+
+	// Transpose the planes of each group of four hulls into plane rows.
+	const int32 NumGroups = (PendingHulls.Num() + 3) / 4;
+	GroupPlaneStart.Reset(NumGroups);
+	GroupPlaneCount.Reset(NumGroups);
+	PlaneX.Reset();
+	PlaneY.Reset();
+	PlaneZ.Reset();
+	PlaneW.Reset();
+
+	for (int32 GroupIndex = 0; GroupIndex < NumGroups; GroupIndex++)
+	{
+		int32 NumRows = 0;
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			const int32 HullIndex = GroupIndex * 4 + Lane;
+			if (PendingHulls.IsValidIndex(HullIndex))
+				NumRows = FMath::Max(NumRows, PendingHulls[HullIndex].Value.Num());
+		}
+
+		GroupPlaneStart.Add(PlaneX.Num() / 4);
+		GroupPlaneCount.Add(NumRows);
+
+		for (int32 Row = 0; Row < NumRows; Row++)
+		{
+			for (int32 Lane = 0; Lane < 4; Lane++)
+			{
+				const int32 HullIndex = GroupIndex * 4 + Lane;
+
+				// Empty lanes are always outside, short hulls are padded with planes that are always inside.
+				FPlane Plane(0.f, 0.f, 0.f, -1.f);
+				if (PendingHulls.IsValidIndex(HullIndex))
+				{
+					const TArray<FPlane>& Planes = PendingHulls[HullIndex].Value;
+					Plane = Planes.IsValidIndex(Row) ? Planes[Row] : FPlane(0.f, 0.f, 0.f, 1.f);
+				}
+
+				PlaneX.Add((float)Plane.X);
+				PlaneY.Add((float)Plane.Y);
+				PlaneZ.Add((float)Plane.Z);
+				PlaneW.Add((float)Plane.W);
+			}
+		}
+	}
+
+	PendingHulls.Empty();
+}
+
+/// <summary>
+/// Returns true if the location is inside any hull of the zone.
+/// </summary>
+/// <param name="ZoneIndex">Zone index.</param>
+/// <param name="Location">World location.</param>
+bool FFixedCameraZoneHulls::IsInZone(int32 ZoneIndex, const FVector& Location) const
+{
+	if (!ZoneHullCount.IsValidIndex(ZoneIndex) || ZoneHullCount[ZoneIndex] == 0)
+		return false;
+
+	const int32 FirstHull = ZoneHullStart[ZoneIndex];
+	const int32 LastHull = FirstHull + ZoneHullCount[ZoneIndex] - 1;
+
+	for (int32 GroupIndex = FirstHull / 4; GroupIndex <= LastHull / 4; GroupIndex++)
+	{
+		int32 InsideMask = TestGroup(GroupIndex, Location);
+		for (int32 Lane = 0; Lane < 4 && InsideMask; Lane++)
+		{
+			const int32 HullIndex = GroupIndex * 4 + Lane;
+			if ((InsideMask & (1 << Lane)) && HullIndex >= FirstHull && HullIndex <= LastHull)
+				return true;
+		}
+	}
+
+	return false;
+}
+
+/// <summary>
+/// Returns the first zone containing the location, testing four hulls per step.
+/// </summary>
+/// <param name="Location">World location.</param>
+int32 FFixedCameraZoneHulls::FindZone(const FVector& Location) const
+{
+	for (int32 GroupIndex = 0; GroupIndex < GroupPlaneStart.Num(); GroupIndex++)
+	{
+		const int32 InsideMask = TestGroup(GroupIndex, Location);
+		if (InsideMask)
+			return HullZones[GroupIndex * 4 + FMath::CountTrailingZeros((uint32)InsideMask)];
+	}
+
+	return INDEX_NONE;
+}
+
+/// <summary>
+/// Writes the first zone containing each location, testing four locations per step.
+/// </summary>
+/// <param name="Locations">World locations.</param>
+/// <param name="OutZones">Zone per location (INDEX_NONE if outside every zone). Must have the same size as Locations.</param>
+void FFixedCameraZoneHulls::FindZones(TArrayView<const FVector> Locations, TArrayView<int32> OutZones) const
+{
+	check(Locations.Num() == OutZones.Num());
+
+	alignas(16) float BatchX[4];
+	alignas(16) float BatchY[4];
+	alignas(16) float BatchZ[4];
+
+	for (int32 First = 0; First < Locations.Num(); First += 4)
+	{
+		const int32 NumLanes = FMath::Min(4, Locations.Num() - First);
+
+		// Transpose four locations into lanes, repeating the last one in unused lanes.
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			const FVector& Location = Locations[First + FMath::Min(Lane, NumLanes - 1)];
+			BatchX[Lane] = (float)Location.X;
+			BatchY[Lane] = (float)Location.Y;
+			BatchZ[Lane] = (float)Location.Z;
+			if (Lane < NumLanes)
+				OutZones[First + Lane] = INDEX_NONE;
+		}
+
+		const FFixedCameraVectorRegister LocationX = VectorLoadAligned(BatchX);
+		const FFixedCameraVectorRegister LocationY = VectorLoadAligned(BatchY);
+		const FFixedCameraVectorRegister LocationZ = VectorLoadAligned(BatchZ);
+
+		int32 PendingMask = (1 << NumLanes) - 1;
+
+		for (int32 HullIndex = 0; HullIndex < HullZones.Num() && PendingMask; HullIndex++)
+		{
+			const int32 GroupIndex = HullIndex / 4;
+			const int32 HullLane = HullIndex % 4;
+			const int32 FirstRow = GroupPlaneStart[GroupIndex];
+			const int32 LastRow = FirstRow + GroupPlaneCount[GroupIndex];
+
+			FFixedCameraVectorRegister Outside = VectorZero();
+
+			for (int32 Row = FirstRow; Row < LastRow; Row++)
+			{
+				const int32 PlaneIndex = Row * 4 + HullLane;
+				const FFixedCameraVectorRegister Distance = VectorSubtract(
+					VectorMultiplyAdd(VectorSetFloat1(PlaneX[PlaneIndex]), LocationX,
+						VectorMultiplyAdd(VectorSetFloat1(PlaneY[PlaneIndex]), LocationY,
+							VectorMultiply(VectorSetFloat1(PlaneZ[PlaneIndex]), LocationZ))),
+					VectorSetFloat1(PlaneW[PlaneIndex]));
+
+				Outside = VectorBitwiseOr(Outside, VectorCompareGT(Distance, VectorZero()));
+			}
+
+			int32 InsideMask = ~VectorMaskBits(Outside) & PendingMask;
+			PendingMask &= ~InsideMask;
+
+			while (InsideMask)
+			{
+				const int32 Lane = FMath::CountTrailingZeros((uint32)InsideMask);
+				OutZones[First + Lane] = HullZones[HullIndex];
+				InsideMask &= InsideMask - 1;
+			}
+		}
+	}
+}
+
+/// <summary>
+/// Returns a bit per lane of the group whose hull contains the location.
+/// </summary>
+/// <param name="GroupIndex">Group of four hulls.</param>
+/// <param name="Location">World location.</param>
+int32 FFixedCameraZoneHulls::TestGroup(int32 GroupIndex, const FVector& Location) const
+{
+	const FFixedCameraVectorRegister LocationX = VectorSetFloat1((float)Location.X);
+	const FFixedCameraVectorRegister LocationY = VectorSetFloat1((float)Location.Y);
+	const FFixedCameraVectorRegister LocationZ = VectorSetFloat1((float)Location.Z);
+
+	FFixedCameraVectorRegister Outside = VectorZero();
+
+	const int32 FirstRow = GroupPlaneStart[GroupIndex];
+	const int32 LastRow = FirstRow + GroupPlaneCount[GroupIndex];
+
+	for (int32 Row = FirstRow; Row < LastRow; Row++)
+	{
+		const FFixedCameraVectorRegister Distance = VectorSubtract(
+			VectorMultiplyAdd(VectorLoadAligned(&PlaneX[Row * 4]), LocationX,
+				VectorMultiplyAdd(VectorLoadAligned(&PlaneY[Row * 4]), LocationY,
+					VectorMultiply(VectorLoadAligned(&PlaneZ[Row * 4]), LocationZ))),
+			VectorLoadAligned(&PlaneW[Row * 4]));
+
+		Outside = VectorBitwiseOr(Outside, VectorCompareGT(Distance, VectorZero()));
+	}
+
+	return ~VectorMaskBits(Outside) & 0xF;
+}
+#pragma endregion
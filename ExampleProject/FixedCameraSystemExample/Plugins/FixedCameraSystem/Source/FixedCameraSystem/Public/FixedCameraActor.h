@@ -10,26 +10,10 @@
 #include "Components/BillboardComponent.h"
 #include "FixedCameraPath.h"
 #include "Camera/PlayerCameraManager.h"
+#include "FixedCameraGroupBounds.h"
+#include "FixedCameraProfile.h"
 #include "FixedCameraActor.generated.h"
 
-UENUM()
-enum class ECameraFocus
-{
-	NoFocus        UMETA(DisplayName = "No Focus"),
-	FocusOnPlayer  UMETA(DisplayName = "Focus on Player"),
-	FocusOnObject  UMETA(DisplayName = "Focus on Target"),
-	MiddleLocationPlayerAndInitialFocus  UMETA(DisplayName = "Middle location (Player and Initial Focus)"),
-	MiddleLocationPlayerAndObject		 UMETA(DisplayName = "Middle location (Player and Target)"),
-};
-
-UENUM()
-enum class ECameraType
-{
-	Static  UMETA(DisplayName = "Static Camera"),
-	Rail    UMETA(DisplayName = "On Rail Camera")
-};
-
-
 UCLASS()
 class FIXEDCAMERASYSTEM_API AFixedCameraActor : public AActor
 {
@@ -41,6 +25,24 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings", DisplayName = "Activate on Play", Tooltip = "Initializes this camera by default."))
 	bool bDefaultCamera;
 	
+	/// <summary>
+	/// Unique identifier used by the camera queries. The actor name is used if none.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings", DisplayName = "Camera ID", Tooltip = "Unique identifier used by the camera queries. The actor name is used if none."))
+	FName CameraId;
+
+	/// <summary>
+	/// Shared settings asset. The settings checked in Profile Overrides replace its values.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Fixed Camera Settings", DisplayName = "Profile", Tooltip = "Shared settings asset. The settings checked in Profile Overrides replace its values."))
+	UFixedCameraProfile* Profile;
+
+	/// <summary>
+	/// Settings of this camera that replace the ones of its profile, or the default ones if no profile is set.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetProfileOverrides, meta = (Category = "Fixed Camera Settings", DisplayName = "Profile Overrides", Tooltip = "Settings of this camera that replace the ones of its profile, or the default ones if no profile is set."))
+	FFixedCameraProfileOverrides ProfileOverrides;
+
 	/// <summary>
 	/// Defines the type of camera: Static or On Rail.
 	/// </summary>
@@ -54,58 +56,137 @@ public:
 	class AFixedCameraPath* CameraRail;
 
 	/// <summary>
-	/// Distance to reach the last point of the rail.
+	/// Focus target actor reference.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Focus Parameters", Tooltip = "Focus target actor reference."))
+	class AActor* FocusTarget;
+
+	/// <summary>
+	/// Initial members of the framed group.
 	/// </summary>
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings", DisplayName = "Rail Travelling Distance", EditCondition = "CameraType == ECameraType::Rail", EditConditionHides, Tooltip = "Distance to reach the last point of the rail."))
-	float fRailTravellingDistance = 2000.f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Fixed Camera Settings|Focus Parameters", DisplayName = "Focus Group", Tooltip = "Initial members of the framed group."))
+	TArray<AActor*> FocusGroup;
 
 	/// <summary>
-	/// Determines if smooth movement will be used.
+	/// Auto-Disables tick after deactivating the camera.
 	/// </summary>
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings", DisplayName = "Smooth Movement", EditCondition = "CameraType == ECameraType::Rail", EditConditionHides, Tooltip = "Determines if smooth movement will be used."))
-	bool bSmoothMovement = true;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Optimization", DisplayName = "Auto-Deactivate Tick Method", Tooltip = "Auto-Disables tick after deactivating the camera."))
+	bool bAutoDeactivateTickMethod;
 
 	/// <summary>
-	/// Smoothness movement velocity.
+	/// Registers this camera as an additional texture and mesh streaming view while it is the next likely camera.
 	/// </summary>
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings", DisplayName = "Smooth Movement Speed", EditCondition = "bSmoothMovement && CameraType == ECameraType::Rail", EditConditionHides, Tooltip = "Smoothness movement velocity.", ClampMin = "0.0"))
-	float fSmoothMovementSpeed = 3.f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Optimization", DisplayName = "Stream When Upcoming", Tooltip = "Registers this camera as an additional texture and mesh streaming view while it is the next likely camera."))
+	bool bStreamWhenUpcoming = true;
 
 	/// <summary>
-	/// Camera focus type.
+	/// Prefetches the content seen by this camera as soon as it becomes the next likely camera.
 	/// </summary>
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Focus Parameters", Tooltip = "Camera focus type."))
-	ECameraFocus CameraFocus;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Optimization", DisplayName = "Prefetch When Upcoming", EditCondition = "bStreamWhenUpcoming", EditConditionHides, Tooltip = "Prefetches the content seen by this camera as soon as it becomes the next likely camera."))
+	bool bPrefetchWhenUpcoming;
 
 	/// <summary>
-	/// Focus target actor reference.
+	/// Seconds the prefetched content is kept at full resolution.
 	/// </summary>
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Focus Parameters", EditCondition = "CameraFocus == ECameraFocus::FocusOnObject || CameraFocus == ECameraFocus::MiddleLocationPlayerAndObject", EditConditionHides, Tooltip = "Focus target actor reference."))
-	class AActor* FocusTarget;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Optimization", DisplayName = "Prefetch Duration", EditCondition = "bStreamWhenUpcoming && bPrefetchWhenUpcoming", EditConditionHides, ClampMin = "0.0", Tooltip = "Seconds the prefetched content is kept at full resolution."))
+	float fPrefetchDuration = 3.f;
 
 	/// <summary>
-	/// Middle point alpha (0 to 1).
+	/// Hides the static actors that are not in the baked visibility set while this camera is active.
 	/// </summary>
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Focus Parameters", EditCondition = "CameraFocus == ECameraFocus::MiddleLocationPlayerAndObject || CameraFocus == ECameraFocus::MiddleLocationPlayerAndInitialFocus", EditConditionHides, Tooltip = "Middle point alpha (0 to 1).", DisplayName = "Middle Point Alpha", ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0"))
-	float fMiddlePointAlpha = 0.25f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Optimization", DisplayName = "Use Visibility Set", Tooltip = "Hides the static actors that are not in the baked visibility set while this camera is active."))
+	bool bUseVisibilitySet;
 
 	/// <summary>
-	/// Determines if smooth rotation will be used.
+	/// Also disables the tick of the hidden actors.
 	/// </summary>
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Focus Parameters", DisplayName = "Smooth Rotation", EditCondition = "CameraFocus != ECameraFocus::NoFocus", EditConditionHides, Tooltip = "Determines if smooth rotation will be used."))
-	bool bSmoothRotation = true;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Optimization", DisplayName = "Disable Tick Outside View", EditCondition = "bUseVisibilitySet", EditConditionHides, Tooltip = "Also disables the tick of the hidden actors."))
+	bool bDisableTickOutsideView;
 
 	/// <summary>
-	/// Smoothness rotation velocity.
+	/// Number of positions along the rail used by the visibility bake.
 	/// </summary>
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Focus Parameters", DisplayName = "Smooth Rotation Speed", EditCondition = "bSmoothRotation && CameraFocus != ECameraFocus::NoFocus", EditConditionHides, Tooltip = "Smoothness rotation velocity.", ClampMin = "0.0"))
-	float fSmoothRotationSpeed = 3.f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Optimization", DisplayName = "Rail Visibility Samples", EditCondition = "bUseVisibilitySet && CameraType == ECameraType::Rail", EditConditionHides, ClampMin = "2", Tooltip = "Number of positions along the rail used by the visibility bake."))
+	int32 RailVisibilitySamples = 8;
 
 	/// <summary>
-	/// Auto-Disables tick after deactivating the camera.
+	/// Baked static actors that can be visible from this camera.
 	/// </summary>
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Optimization", DisplayName = "Auto-Deactivate Tick Method", Tooltip = "Auto-Disables tick after deactivating the camera."))
-	bool bAutoDeactivateTickMethod;
+	UPROPERTY(VisibleAnywhere, meta = (Category = "Fixed Camera Settings|Optimization", DisplayName = "Visibility Set", EditCondition = "bUseVisibilitySet", EditConditionHides, Tooltip = "Baked static actors that can be visible from this camera."))
+	TArray<AActor*> VisibilitySet;
+
+	/// <summary>
+	/// Traces the player and focus target from this camera while it is active to report occlusion.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Occlusion", DisplayName = "Trace Occlusion", Tooltip = "Traces the player and focus target from this camera while it is active to report occlusion."))
+	bool bTraceOcclusion = true;
+
+	/// <summary>
+	/// Collision channel of the occlusion traces.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Occlusion", DisplayName = "Occlusion Channel", EditCondition = "bTraceOcclusion", EditConditionHides, Tooltip = "Collision channel of the occlusion traces."))
+	TEnumAsByte<ECollisionChannel> OcclusionChannel = ECC_Camera;
+
+	/// <summary>
+	/// Fades out the meshes between this camera and the player while it is active.
+	/// Their materials need a scalar opacity parameter (e.g. dithered masked opacity).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Occlusion", DisplayName = "Fade Occluders", Tooltip = "Fades out the meshes between this camera and the player while it is active. Their materials need a scalar opacity parameter (e.g. dithered masked opacity)."))
+	bool bFadeOccluders;
+
+	/// <summary>
+	/// Radius of the sweep that finds the occluders.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Occlusion", DisplayName = "Occluder Sweep Radius", EditCondition = "bFadeOccluders", EditConditionHides, ClampMin = "0.0", Tooltip = "Radius of the sweep that finds the occluders."))
+	float fOccluderSweepRadius = 30.f;
+
+	/// <summary>
+	/// Opacity of the faded occluders.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Occlusion", DisplayName = "Occluder Faded Opacity", EditCondition = "bFadeOccluders", EditConditionHides, ClampMin = "0.0", ClampMax = "1.0", Tooltip = "Opacity of the faded occluders."))
+	float fOccluderFadedOpacity = 0.2f;
+
+	/// <summary>
+	/// Opacity change per second.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Occlusion", DisplayName = "Occluder Fade Speed", EditCondition = "bFadeOccluders", EditConditionHides, ClampMin = "0.0", Tooltip = "Opacity change per second."))
+	float fOccluderFadeSpeed = 4.f;
+
+	/// <summary>
+	/// Scalar material parameter driven by the fade.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Occlusion", DisplayName = "Occluder Opacity Parameter", EditCondition = "bFadeOccluders", EditConditionHides, Tooltip = "Scalar material parameter driven by the fade."))
+	FName OccluderOpacityParameter = TEXT("Opacity");
+
+	/// <summary>
+	/// Acts as a World Partition streaming source while this camera is active (UE5 only).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Streaming", DisplayName = "World Partition Streaming Source", Tooltip = "Acts as a World Partition streaming source while this camera is active (UE5 only)."))
+	bool bIsStreamingSource;
+
+	/// <summary>
+	/// Also acts as a streaming source while this camera is the next likely camera.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Streaming", DisplayName = "Streaming Source When Upcoming", EditCondition = "bIsStreamingSource", EditConditionHides, Tooltip = "Also acts as a streaming source while this camera is the next likely camera."))
+	bool bStreamingSourceWhenUpcoming = true;
+
+	/// <summary>
+	/// Loading range of the streaming source, shaped as a sector matching the camera field of view.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Streaming", DisplayName = "Streaming Source Range", EditCondition = "bIsStreamingSource", EditConditionHides, ClampMin = "0.0", Tooltip = "Loading range of the streaming source, shaped as a sector matching the camera field of view."))
+	float fStreamingSourceRange = 5000.f;
+
+	/// <summary>
+	/// Sublevels loaded while this camera is active and unloaded after it blends out.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Streaming", DisplayName = "Sublevels", Tooltip = "Sublevels loaded while this camera is active and unloaded after it blends out."))
+	TArray<TSoftObjectPtr<UWorld>> Sublevels;
+
+	/// <summary>
+	/// Loads the sublevels (hidden) while this camera is the next likely camera.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Settings|Streaming", DisplayName = "Preload Sublevels When Upcoming", Tooltip = "Loads the sublevels (hidden) while this camera is the next likely camera."))
+	bool bPreloadSublevelsWhenUpcoming = true;
 
 	/// <summary>
 	/// Camera component (Root).
@@ -114,6 +195,17 @@ public:
 	UCameraComponent* Camera;
 
 private:
+	/// <summary>
+	/// World Partition streaming source, created on first use.
+	/// </summary>
+	UPROPERTY(Transient)
+	UActorComponent* StreamingSourceComponent;
+
+	/// <summary>
+	/// Settings resolved from the profile and overrides, read every frame. Not saved, resolved again by BeginPlay and the setters.
+	/// </summary>
+	FFixedCameraSettings Settings;
+
 	/// <summary>
 	/// First frame camera rotation.
 	/// </summary>
@@ -124,6 +216,65 @@ private:
 	/// </summary>
 	AActor* PlayerCharacterActorReference;
 
+	/// <summary>
+	/// Player lookup and focus setup are done (on first activation).
+	/// </summary>
+	bool bInitialized;
+
+	/// <summary>
+	/// The settings passed the validation done on registration.
+	/// </summary>
+	bool bValidSettings;
+
+	/// <summary>
+	/// Skips the smoothing of the next update.
+	/// </summary>
+	bool bSnapView;
+
+	/// <summary>
+	/// Members of the framed group.
+	/// </summary>
+	FFixedCameraGroupBounds GroupBounds;
+
+	/// <summary>
+	/// Rotates the camera just enough to bring the focus direction back to the dead zone.
+	/// </summary>
+	/// <param name="FocusDirection">World direction to the focus point.</param>
+	/// <param name="OutRotation">New camera rotation.</param>
+	/// <returns>False if the focus point is inside the dead zone (no rotation update).</returns>
+	bool ComposeDeadZone(const FVector& FocusDirection, FRotator& OutRotation) const;
+
+	/// <summary>
+	/// Fills the settings from the defaults or the profile, then from the overrides.
+	/// </summary>
+	/// <param name="OutSettings">Resolved settings.</param>
+	void ResolveSettings(FFixedCameraSettings& OutSettings) const;
+
+	/// <summary>
+	/// Resolves the settings and applies their field of view to the camera.
+	/// </summary>
+	void ApplySettings();
+
+#if WITH_EDITORONLY_DATA
+	/// <summary>
+	/// Settings saved on the camera before the profile overrides, moved into them on load.
+	/// </summary>
+	UPROPERTY()
+	float fRailTravellingDistance_DEPRECATED = 2000.f;
+	UPROPERTY()
+	bool bSmoothMovement_DEPRECATED = true;
+	UPROPERTY()
+	float fSmoothMovementSpeed_DEPRECATED = 3.f;
+	UPROPERTY()
+	ECameraFocus CameraFocus_DEPRECATED = ECameraFocus::NoFocus;
+	UPROPERTY()
+	float fMiddlePointAlpha_DEPRECATED = 0.25f;
+	UPROPERTY()
+	bool bSmoothRotation_DEPRECATED = true;
+	UPROPERTY()
+	float fSmoothRotationSpeed_DEPRECATED = 3.f;
+#endif
+
 public:	
 
 	/// <summary>
@@ -138,11 +289,22 @@ protected:
 	/// <param name="Transform">Actor transform.</param>
 	virtual void OnConstruction(const FTransform& Transform) override;
 
+	/// <summary>
+	/// Moves the settings saved before the profile overrides into them.
+	/// </summary>
+	virtual void PostLoad() override;
+
 	/// <summary>
 	/// Called when the game starts or when spawned
 	/// </summary>
 	virtual void BeginPlay() override;
 
+	/// <summary>
+	/// Called when the actor is removed from the level.
+	/// </summary>
+	/// <param name="EndPlayReason">End play reason.</param>
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
 	/// <summary>
 	/// Called every frame.
@@ -150,6 +312,37 @@ public:
 	/// <param name="DeltaTime">Time between frames.</param>
 	virtual void Tick(float DeltaTime) override;
 
+	/// <summary>
+	/// Resolves the settings and checks the references they need. Shows an error and quits the game if one is missing. Called on registration.
+	/// </summary>
+	/// <returns>False if the camera settings are not valid.</returns>
+	bool ValidateFixedCamera();
+
+	/// <summary>
+	/// Looks up the player and prepares the focus. Called on first activation.
+	/// </summary>
+	/// <returns>False if the camera settings are not valid.</returns>
+	bool InitializeFixedCamera();
+
+	/// <summary>
+	/// Clears the first activation state and resolves the settings again, so the camera can be reused with other settings.
+	/// </summary>
+	void ResetFixedCamera();
+
+	/// <summary>
+	/// Returns the position of the camera along its rail (0 = start, 1 = end, 0 for static cameras).
+	/// </summary>
+	float GetRailProgress() const;
+
+	/// <summary>
+	/// Initializes the camera and places it at a saved view, so the next update continues from it without snapping.
+	/// </summary>
+	/// <param name="fRailProgress">Position along the rail (0 = start, 1 = end).</param>
+	/// <param name="ViewRotation">Camera rotation.</param>
+	/// <param name="fViewFieldOfView">Camera field of view.</param>
+	/// <returns>False if the camera settings are not valid.</returns>
+	bool RestoreFixedCameraView(float fRailProgress, const FRotator& ViewRotation, float fViewFieldOfView);
+
 	/// <summary>
 	/// Activates the camera actor.
 	/// </summary>
@@ -162,4 +355,63 @@ public:
 	/// Deactivates the camera actor.
 	/// </summary>
 	void DeactivateFixedCamera();
+
+	/// <summary>
+	/// Returns the camera identifier (the actor name if no Camera ID is set).
+	/// </summary>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns the camera identifier (the actor name if no Camera ID is set)."))
+	FName GetCameraId() const;
+
+	/// <summary>
+	/// Returns the settings used by the camera.
+	/// </summary>
+	const FFixedCameraSettings& GetSettings() const { return Settings; }
+
+	/// <summary>
+	/// Returns the resolved focus type.
+	/// </summary>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns the resolved focus type."))
+	ECameraFocus GetCameraFocus() const;
+
+	/// <summary>
+	/// Replaces the profile and resolves the settings again.
+	/// </summary>
+	/// <param name="NewProfile">Shared settings asset (none uses the default settings).</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Replaces the profile and resolves the settings again."))
+	void SetProfile(UFixedCameraProfile* NewProfile);
+
+	/// <summary>
+	/// Replaces the overridden settings and resolves the settings again.
+	/// </summary>
+	/// <param name="NewProfileOverrides">Settings that replace the ones of the profile.</param>
+	UFUNCTION(BlueprintSetter)
+	void SetProfileOverrides(const FFixedCameraProfileOverrides& NewProfileOverrides);
+
+	/// <summary>
+	/// Adds an actor to the framed group.
+	/// </summary>
+	/// <param name="Actor">New member.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Adds an actor to the framed group."))
+	void AddToFocusGroup(AActor* Actor);
+
+	/// <summary>
+	/// Removes an actor from the framed group.
+	/// </summary>
+	/// <param name="Actor">Member.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Removes an actor from the framed group."))
+	void RemoveFromFocusGroup(AActor* Actor);
+
+	/// <summary>
+	/// Enables or disables the World Partition streaming source of the camera (no-op before UE5).
+	/// </summary>
+	/// <param name="bEnabled">Streams around the camera view.</param>
+	void SetStreamingSourceEnabled(bool bEnabled);
+
+#if WITH_EDITOR
+	/// <summary>
+	/// Traces the bounds of every static actor from the camera (or along its rail) and stores the ones that can be visible.
+	/// </summary>
+	UFUNCTION(CallInEditor, meta = (Category = "Fixed Camera Settings|Optimization", DisplayName = "Bake Visibility Set", Tooltip = "Traces the bounds of every static actor from the camera (or along its rail) and stores the ones that can be visible."))
+	void BakeVisibilitySet();
+#endif
 };
@@ -0,0 +1,81 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FConvexVolume;
+
+/// <summary>
+/// View frustum planes of a fixed camera, tested against four points, spheres or boxes at a time.
+/// Outside is where Plane.PlaneDot(Location) is greater than the tested radius.
+/// </summary>
+struct FIXEDCAMERASYSTEM_API FFixedCameraFrustum
+{
+public:
+	/// <summary>
+	/// Copies the planes of a convex volume.
+	/// </summary>
+	/// <param name="Volume">View frustum.</param>
+	void Build(const FConvexVolume& Volume);
+
+	/// <summary>
+	/// Returns true if the frustum has been built.
+	/// </summary>
+	bool IsValid() const { return PlaneX.Num() > 0; }
+
+	/// <summary>
+	/// Returns true if the point is inside the frustum.
+	/// </summary>
+	/// <param name="Point">World location.</param>
+	bool ContainsPoint(const FVector& Point) const;
+
+	/// <summary>
+	/// Returns true if the sphere intersects the frustum.
+	/// </summary>
+	/// <param name="Center">Sphere center.</param>
+	/// <param name="Radius">Sphere radius.</param>
+	bool IntersectsSphere(const FVector& Center, float Radius) const;
+
+	/// <summary>
+	/// Returns true if the box intersects the frustum.
+	/// </summary>
+	/// <param name="Box">World box.</param>
+	bool IntersectsBox(const FBox& Box) const;
+
+	/// <summary>
+	/// Writes whether each point is inside the frustum.
+	/// </summary>
+	/// <param name="Points">World locations.</param>
+	/// <param name="OutInside">Result per point. Must have the same size as Points.</param>
+	void ContainsPoints(TArrayView<const FVector> Points, TArrayView<bool> OutInside) const;
+
+	/// <summary>
+	/// Writes whether each sphere intersects the frustum.
+	/// </summary>
+	/// <param name="Centers">Sphere centers.</param>
+	/// <param name="Radii">Sphere radii. Must have the same size as Centers.</param>
+	/// <param name="OutInside">Result per sphere. Must have the same size as Centers.</param>
+	void IntersectsSpheres(TArrayView<const FVector> Centers, TArrayView<const float> Radii, TArrayView<bool> OutInside) const;
+
+	/// <summary>
+	/// Writes whether each box intersects the frustum.
+	/// </summary>
+	/// <param name="Boxes">World boxes.</param>
+	/// <param name="OutInside">Result per box. Must have the same size as Boxes.</param>
+	void IntersectsBoxes(TArrayView<const FBox> Boxes, TArrayView<bool> OutInside) const;
+
+private:
+	/// <summary>
+	/// Returns a bit per lane whose sphere (or box of the given extents) is outside any plane.
+	/// </summary>
+	int32 TestLanes(const float* X, const float* Y, const float* Z, const float* R, const float* EX, const float* EY, const float* EZ) const;
+
+	/// <summary>
+	/// Plane components, one entry per plane.
+	/// </summary>
+	TArray<float, TAlignedHeapAllocator<16>> PlaneX;
+	TArray<float, TAlignedHeapAllocator<16>> PlaneY;
+	TArray<float, TAlignedHeapAllocator<16>> PlaneZ;
+	TArray<float, TAlignedHeapAllocator<16>> PlaneW;
+};
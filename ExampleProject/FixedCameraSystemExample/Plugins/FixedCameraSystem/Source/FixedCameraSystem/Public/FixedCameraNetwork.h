@@ -0,0 +1,166 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// <summary>
+/// Versions of the camera network file. New versions are added before LatestVersion.
+/// </summary>
+enum class EFixedCameraNetworkVersion : uint32
+{
+	Initial = 1,
+
+	VersionPlusOne,
+	LatestVersion = VersionPlusOne - 1
+};
+
+/// <summary>
+/// Camera record: a transform, a field of view, a focus type and an optional rail.
+/// </summary>
+struct FFixedCameraNetworkCamera
+{
+	int32 NameIndex;
+	float Location[3];
+	float Rotation[3];
+	float fFieldOfView;
+	int32 RailIndex;
+	uint8 CameraFocus;
+	uint8 Padding[3];
+
+	friend FArchive& operator<<(FArchive& Ar, FFixedCameraNetworkCamera& Camera);
+};
+
+/// <summary>
+/// Rail record: a range of the polyline points.
+/// </summary>
+struct FFixedCameraNetworkRail
+{
+	int32 FirstPoint;
+	int32 NumPoints;
+
+	friend FArchive& operator<<(FArchive& Ar, FFixedCameraNetworkRail& Rail);
+};
+
+/// <summary>
+/// Rail polyline point.
+/// </summary>
+struct FFixedCameraNetworkPoint
+{
+	float X;
+	float Y;
+	float Z;
+
+	friend FArchive& operator<<(FArchive& Ar, FFixedCameraNetworkPoint& Point);
+};
+
+/// <summary>
+/// Zone record: a box rotated around Z, the camera activated inside it and a range of transitions.
+/// </summary>
+struct FFixedCameraNetworkZone
+{
+	int32 NameIndex;
+	int32 CameraIndex;
+	float Center[3];
+	float fYaw;
+	float Extent[3];
+	int32 FirstTransition;
+	int32 NumTransitions;
+
+	friend FArchive& operator<<(FArchive& Ar, FFixedCameraNetworkZone& Zone);
+};
+
+/// <summary>
+/// Transition record: the adjacent zone and the blend used to reach it.
+/// </summary>
+struct FFixedCameraNetworkTransition
+{
+	int32 TargetZone;
+	float fSmoothTransition;
+	float fBlendExp;
+	uint8 BlendFunc;
+	uint8 Padding[3];
+
+	friend FArchive& operator<<(FArchive& Ar, FFixedCameraNetworkTransition& Transition);
+};
+
+/// <summary>
+/// Whole camera network (cameras, rails, zones and transitions) in flat arrays of plain records.
+/// Every array is bulk serialized, so a file is read with a few copies and no object construction.
+/// </summary>
+struct FIXEDCAMERASYSTEM_API FFixedCameraNetwork
+{
+public:
+	/// <summary>
+	/// Camera and zone names, referenced by index.
+	/// </summary>
+	TArray<FString> Names;
+
+	TArray<FFixedCameraNetworkCamera> Cameras;
+	TArray<FFixedCameraNetworkRail> Rails;
+	TArray<FFixedCameraNetworkPoint> RailPoints;
+	TArray<FFixedCameraNetworkZone> Zones;
+	TArray<FFixedCameraNetworkTransition> Transitions;
+
+	/// <summary>
+	/// Reads or writes the network.
+	/// </summary>
+	/// <param name="Ar">Archive.</param>
+	/// <returns>False if the data is not a valid network.</returns>
+	bool Serialize(FArchive& Ar);
+
+	/// <summary>
+	/// Reads a network file, memory-mapped if the platform allows it or streamed otherwise.
+	/// </summary>
+	/// <param name="FilePath">Network file.</param>
+	/// <returns>False if the file could not be read or is not a valid network.</returns>
+	bool LoadFromFile(const FString& FilePath);
+
+	/// <summary>
+	/// Writes the network to a file.
+	/// </summary>
+	/// <param name="FilePath">Network file.</param>
+	/// <returns>False if the file could not be written.</returns>
+	bool SaveToFile(const FString& FilePath);
+
+	/// <summary>
+	/// Removes every record.
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// Returns the length of a rail.
+	/// </summary>
+	/// <param name="RailIndex">Rail.</param>
+	float GetRailLength(int32 RailIndex) const;
+
+	/// <summary>
+	/// Returns the location at a distance along a rail.
+	/// </summary>
+	/// <param name="RailIndex">Rail.</param>
+	/// <param name="fDistance">Distance from the first point.</param>
+	FVector GetLocationAlongRail(int32 RailIndex, float fDistance) const;
+
+	/// <summary>
+	/// Returns true if the location is inside a zone.
+	/// </summary>
+	/// <param name="ZoneIndex">Zone.</param>
+	/// <param name="Location">Location, in the space of the network.</param>
+	bool IsInZone(int32 ZoneIndex, const FVector& Location) const;
+
+private:
+	/// <summary>
+	/// Checks that every index references an existing record.
+	/// </summary>
+	bool Validate() const;
+
+	/// <summary>
+	/// Accumulated distance of each rail point from the first point of its rail (computed on load).
+	/// </summary>
+	TArray<float> RailPointDistances;
+
+	/// <summary>
+	/// Computes the accumulated distances of the rail points.
+	/// </summary>
+	void BuildRailDistances();
+};
@@ -0,0 +1,121 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FixedCameraSnapshot.generated.h"
+
+/// <summary>
+/// Versions of the camera snapshot. New versions are added before LatestVersion.
+/// </summary>
+enum class EFixedCameraSnapshotVersion : uint8
+{
+	Initial = 1,
+
+	VersionPlusOne,
+	LatestVersion = VersionPlusOne - 1
+};
+
+/// <summary>
+/// Role of a saved camera.
+/// </summary>
+enum class EFixedCameraSnapshotFlags : uint8
+{
+	None = 0,
+	Active = 1 << 0,
+	BlendingOut = 1 << 1
+};
+ENUM_CLASS_FLAGS(EFixedCameraSnapshotFlags);
+
+/// <summary>
+/// Camera record: the quantized view of an active or blending out camera (15 bytes).
+/// </summary>
+struct FFixedCameraSnapshotCamera
+{
+	/// <summary>
+	/// CRC of the lowercase camera identifier.
+	/// </summary>
+	uint32 CameraIdHash;
+	uint8 Flags;
+
+	/// <summary>
+	/// Position along the rail, 0 to 65535.
+	/// </summary>
+	uint16 RailProgress;
+
+	/// <summary>
+	/// Pitch, yaw and roll compressed to shorts.
+	/// </summary>
+	uint16 Rotation[3];
+
+	/// <summary>
+	/// Field of view as a half float.
+	/// </summary>
+	uint16 FieldOfView;
+
+	friend FArchive& operator<<(FArchive& Ar, FFixedCameraSnapshotCamera& Camera);
+};
+
+/// <summary>
+/// Blend record: the view target blend running from the blending out camera to the active one.
+/// </summary>
+struct FFixedCameraSnapshotBlend
+{
+	float fBlendTime;
+	float fBlendTimeToGo;
+	float fBlendExp;
+	uint8 BlendFunc;
+
+	friend FArchive& operator<<(FArchive& Ar, FFixedCameraSnapshotBlend& Blend);
+};
+
+/// <summary>
+/// Zone record: the zone the player is in for a zone graph (6 bytes).
+/// </summary>
+struct FFixedCameraSnapshotZone
+{
+	/// <summary>
+	/// CRC of the lowercase zone graph actor name.
+	/// </summary>
+	uint32 ZoneGraphHash;
+	int16 Zone;
+
+	friend FArchive& operator<<(FArchive& Ar, FFixedCameraSnapshotZone& Zone);
+};
+
+/// <summary>
+/// Compact state of the camera system: the active and blending out cameras, the running blend and the zone of every zone graph.
+/// </summary>
+USTRUCT(BlueprintType)
+struct FIXEDCAMERASYSTEM_API FFixedCameraSnapshot
+{
+	GENERATED_BODY()
+
+	/// <summary>
+	/// Serialized records.
+	/// </summary>
+	UPROPERTY(SaveGame)
+	TArray<uint8> Data;
+
+	TArray<FFixedCameraSnapshotCamera> Cameras;
+	TArray<FFixedCameraSnapshotZone> Zones;
+	FFixedCameraSnapshotBlend Blend;
+	bool bHasBlend = false;
+
+	/// <summary>
+	/// Writes the records into the data.
+	/// </summary>
+	void Pack();
+
+	/// <summary>
+	/// Reads the records from the data.
+	/// </summary>
+	/// <returns>False if the data is not a valid snapshot.</returns>
+	bool Unpack();
+
+	/// <summary>
+	/// Returns the hash stored for a camera identifier or an actor name.
+	/// </summary>
+	/// <param name="Name">Identifier.</param>
+	static uint32 HashName(FName Name);
+};
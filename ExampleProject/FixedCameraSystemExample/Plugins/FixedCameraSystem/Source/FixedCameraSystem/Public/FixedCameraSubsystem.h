@@ -0,0 +1,625 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Engine/EngineBaseTypes.h"
+#include "ConvexVolume.h"
+#include "WorldCollision.h"
+#include "FixedCameraFrustum.h"
+#include "FixedCameraSnapshot.h"
+#include "FixedCameraRecorder.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "FixedCameraSubsystem.generated.h"
+
+class AFixedCameraActor;
+class AFixedCameraZoneGraph;
+class AFixedCameraTrigger;
+class UFixedCameraSignificanceComponent;
+class UFixedCameraOccluderFader;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnFixedCameraOcclusionChanged, AActor*, Target, bool, bOccluded);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnFixedCameraSwitch, AFixedCameraActor*, PreviousCamera, AFixedCameraActor*, NextCamera);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnFixedCameraSwitchNative, AFixedCameraActor* /*PreviousCamera*/, AFixedCameraActor* /*NextCamera*/);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnFixedCameraZoneChanged, AFixedCameraZoneGraph*, ZoneGraph, int32, PreviousZone, int32, NextZone);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnFixedCameraZoneChangedNative, AFixedCameraZoneGraph* /*ZoneGraph*/, int32 /*PreviousZone*/, int32 /*NextZone*/);
+
+/// <summary>
+/// Asynchronous occlusion trace from the active camera to one target.
+/// </summary>
+struct FFixedCameraOcclusionTrace
+{
+	/// <summary>
+	/// Traced actor.
+	/// </summary>
+	TWeakObjectPtr<AActor> Target;
+
+	/// <summary>
+	/// Trace issued last frame.
+	/// </summary>
+	FTraceHandle Handle;
+
+	/// <summary>
+	/// Last consumed result.
+	/// </summary>
+	bool bOccluded = false;
+
+	/// <summary>
+	/// Actors blocking the last consumed trace.
+	/// </summary>
+	TArray<TWeakObjectPtr<AActor>> Occluders;
+};
+
+/// <summary>
+/// Frustum of a camera and the view it was built from.
+/// </summary>
+struct FFixedCameraCachedFrustum
+{
+	FFixedCameraFrustum Frustum;
+	FTransform ViewTransform;
+	float fFieldOfView = 0.f;
+	float fAspectRatio = 0.f;
+};
+
+UCLASS()
+class FIXEDCAMERASYSTEM_API UFixedCameraSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+private:
+	/// <summary>
+	/// Fixed cameras that have begun play.
+	/// </summary>
+	UPROPERTY()
+	TArray<AFixedCameraActor*> Cameras;
+
+	/// <summary>
+	/// Registered cameras by identifier, actor tag and zone name (weak, the cameras are referenced by Cameras).
+	/// </summary>
+	TMap<FName, TWeakObjectPtr<AFixedCameraActor>> CamerasById;
+	TMultiMap<FName, TWeakObjectPtr<AFixedCameraActor>> CamerasByTag;
+	TMap<FName, TWeakObjectPtr<AFixedCameraActor>> CamerasByZone;
+
+	/// <summary>
+	/// Last activated fixed camera.
+	/// </summary>
+	UPROPERTY()
+	AFixedCameraActor* ActiveCamera;
+
+	/// <summary>
+	/// Union of every camera visibility set.
+	/// </summary>
+	UPROPERTY()
+	TSet<AActor*> ManagedActors;
+
+	/// <summary>
+	/// Managed actors hidden by the visibility sets.
+	/// </summary>
+	UPROPERTY()
+	TSet<AActor*> HiddenActors;
+
+	/// <summary>
+	/// Hidden actors whose tick was disabled by the visibility sets.
+	/// </summary>
+	UPROPERTY()
+	TSet<AActor*> TickDisabledActors;
+
+	/// <summary>
+	/// Managed actors must be gathered again.
+	/// </summary>
+	bool bManagedActorsDirty;
+
+	/// <summary>
+	/// Visibility sets must be applied again (a camera with a visibility set registered after the activation).
+	/// </summary>
+	bool bVisibilitySetsDirty;
+
+	/// <summary>
+	/// Previous camera while the blend to the active camera is running.
+	/// </summary>
+	UPROPERTY()
+	AFixedCameraActor* BlendingOutCamera;
+
+	/// <summary>
+	/// Sublevel packages currently loaded by the cameras.
+	/// </summary>
+	TSet<FName> LoadedSublevels;
+
+	/// <summary>
+	/// Timer hiding the previous camera set once the blend has finished.
+	/// </summary>
+	FTimerHandle VisibilityBlendTimer;
+
+	/// <summary>
+	/// Zone graphs that have begun play.
+	/// </summary>
+	UPROPERTY()
+	TArray<AFixedCameraZoneGraph*> ZoneGraphs;
+
+	/// <summary>
+	/// Triggers that have begun play.
+	/// </summary>
+	UPROPERTY()
+	TArray<AFixedCameraTrigger*> Triggers;
+
+	/// <summary>
+	/// Recorded camera views.
+	/// </summary>
+	FFixedCameraRecorder Recorder;
+
+	/// <summary>
+	/// Post actor tick binding recording the camera view while recording.
+	/// </summary>
+	FDelegateHandle RecordingTickHandle;
+
+	/// <summary>
+	/// Cameras reachable from the active camera through the zone graphs and triggers.
+	/// </summary>
+	UPROPERTY()
+	TArray<AFixedCameraActor*> UpcomingCameras;
+
+	/// <summary>
+	/// Upcoming cameras must be gathered again (a zone graph or trigger began play after the activation).
+	/// </summary>
+	bool bUpcomingCamerasDirty;
+
+	/// <summary>
+	/// Significance views must be cached again (a significance component began play after the activation).
+	/// </summary>
+	bool bSignificanceViewsDirty;
+
+	/// <summary>
+	/// Actors driven by the active camera significance.
+	/// </summary>
+	UPROPERTY()
+	TArray<UFixedCameraSignificanceComponent*> SignificanceComponents;
+
+	/// <summary>
+	/// Active camera frustum.
+	/// </summary>
+	FConvexVolume ActiveFrustum;
+
+	/// <summary>
+	/// Zones owned by the active camera, cached on activation.
+	/// </summary>
+	TArray<TPair<AFixedCameraZoneGraph*, int32>> ActiveZones;
+
+	/// <summary>
+	/// Frustums of the cameras adjacent to the active one, cached on activation.
+	/// </summary>
+	TArray<FConvexVolume> AdjacentFrustums;
+
+	/// <summary>
+	/// Occlusion traces of the player (0) and the focus target (1).
+	/// </summary>
+	FFixedCameraOcclusionTrace OcclusionTraces[2];
+
+	/// <summary>
+	/// Query frustums, rebuilt only when the camera view changes.
+	/// </summary>
+	mutable TMap<TWeakObjectPtr<AFixedCameraActor>, FFixedCameraCachedFrustum> CachedFrustums;
+
+	/// <summary>
+	/// Occluder fader, created the first time a camera fades occluders.
+	/// </summary>
+	UPROPERTY()
+	UFixedCameraOccluderFader* OccluderFader;
+
+	/// <summary>
+	/// Time since the last significance update.
+	/// </summary>
+	float fSignificanceTimer;
+
+	/// <summary>
+	/// Seconds between significance updates.
+	/// </summary>
+	static constexpr float SignificanceUpdateInterval = 0.25f;
+
+public:
+	/// <summary>
+	/// Called when the player or the focus target of the active camera becomes occluded or visible.
+	/// </summary>
+	UPROPERTY(BlueprintAssignable, meta = (Category = "Fixed Camera System", Tooltip = "Called when the player or the focus target of the active camera becomes occluded or visible."))
+	FOnFixedCameraOcclusionChanged OnOcclusionChanged;
+
+	/// <summary>
+	/// Called when a camera becomes the view target.
+	/// </summary>
+	UPROPERTY(BlueprintAssignable, meta = (Category = "Fixed Camera System", Tooltip = "Called when a camera becomes the view target."))
+	FOnFixedCameraSwitch OnCameraActivated;
+	FOnFixedCameraSwitchNative OnCameraActivatedNative;
+
+	/// <summary>
+	/// Called when the previous camera stops being the view target (the next camera is null if the new view target is not a fixed camera).
+	/// </summary>
+	UPROPERTY(BlueprintAssignable, meta = (Category = "Fixed Camera System", Tooltip = "Called when the previous camera stops being the view target (the next camera is null if the new view target is not a fixed camera)."))
+	FOnFixedCameraSwitch OnCameraDeactivated;
+	FOnFixedCameraSwitchNative OnCameraDeactivatedNative;
+
+	/// <summary>
+	/// Called when a smooth transition between two cameras starts (not on cuts).
+	/// </summary>
+	UPROPERTY(BlueprintAssignable, meta = (Category = "Fixed Camera System", Tooltip = "Called when a smooth transition between two cameras starts (not on cuts)."))
+	FOnFixedCameraSwitch OnCameraBlendStarted;
+	FOnFixedCameraSwitchNative OnCameraBlendStartedNative;
+
+	/// <summary>
+	/// Called when a smooth transition between two cameras finishes without being interrupted.
+	/// </summary>
+	UPROPERTY(BlueprintAssignable, meta = (Category = "Fixed Camera System", Tooltip = "Called when a smooth transition between two cameras finishes without being interrupted."))
+	FOnFixedCameraSwitch OnCameraBlendFinished;
+	FOnFixedCameraSwitchNative OnCameraBlendFinishedNative;
+
+	/// <summary>
+	/// Called when the player enters another zone of a zone graph.
+	/// </summary>
+	UPROPERTY(BlueprintAssignable, meta = (Category = "Fixed Camera System", Tooltip = "Called when the player enters another zone of a zone graph."))
+	FOnFixedCameraZoneChanged OnZoneChanged;
+	FOnFixedCameraZoneChangedNative OnZoneChangedNative;
+
+	/// <summary>
+	/// Registers a fixed camera and validates its settings (called on world begin play, BeginPlay and pooled camera reuse).
+	/// </summary>
+	/// <param name="Camera">Fixed camera.</param>
+	void RegisterCamera(AFixedCameraActor* Camera);
+
+	/// <summary>
+	/// Unregisters a fixed camera (called on EndPlay).
+	/// </summary>
+	/// <param name="Camera">Fixed camera.</param>
+	void UnregisterCamera(AFixedCameraActor* Camera);
+
+	/// <summary>
+	/// Called by fixed cameras when they become the view target.
+	/// </summary>
+	/// <param name="Camera">Activated camera.</param>
+	/// <param name="fBlendTime">Blend duration.</param>
+	void NotifyCameraActivated(AFixedCameraActor* Camera, float fBlendTime);
+
+	/// <summary>
+	/// Called when a view target that is not a fixed camera replaces the active camera.
+	/// </summary>
+	void NotifyCameraReleased();
+
+	/// <summary>
+	/// Saves the view of the active and blending out cameras, the running blend and the zone of every zone graph.
+	/// </summary>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Saves the view of the active and blending out cameras, the running blend and the zone of every zone graph."))
+	FFixedCameraSnapshot SaveSnapshot() const;
+
+	/// <summary>
+	/// Restores a saved state at once: the saved views are shown on the next frame, without smoothing from the current ones.
+	/// </summary>
+	/// <param name="Snapshot">Saved state.</param>
+	/// <returns>False if the snapshot is not valid or its active camera is not registered.</returns>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Restores a saved state at once: the saved views are shown on the next frame, without smoothing from the current ones."))
+	bool RestoreSnapshot(FFixedCameraSnapshot Snapshot);
+
+	/// <summary>
+	/// Starts recording the final camera view, the active camera and the camera switches, clearing the previous recording.
+	/// </summary>
+	/// <param name="fMaxDuration">Seconds kept, older frames are overwritten.</param>
+	/// <param name="fSampleRate">Recorded frames per second (camera switches are always recorded).</param>
+	/// <param name="fKeyframeInterval">Seconds between keyframes (longer intervals use less memory and sample slower).</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Starts recording the final camera view, the active camera and the camera switches, clearing the previous recording."))
+	void StartRecording(float fMaxDuration = 60.f, float fSampleRate = 30.f, float fKeyframeInterval = 0.5f);
+
+	/// <summary>
+	/// Stops recording, keeping the recorded frames.
+	/// </summary>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Stops recording, keeping the recorded frames."))
+	void StopRecording();
+
+	/// <summary>
+	/// Returns true while the camera view is recorded.
+	/// </summary>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns true while the camera view is recorded."))
+	bool IsRecording() const;
+
+	/// <summary>
+	/// Returns the world time of the first and last recorded frames.
+	/// </summary>
+	/// <returns>False if nothing is recorded.</returns>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns the world time of the first and last recorded frames."))
+	bool GetRecordingTimeRange(float& OutStartTime, float& OutEndTime) const;
+
+	/// <summary>
+	/// Returns the recorded camera view at a world time, without evaluating any camera.
+	/// </summary>
+	/// <param name="fTime">World time (clamped to the recorded range).</param>
+	/// <returns>False if nothing is recorded.</returns>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns the recorded camera view at a world time, without evaluating any camera."))
+	bool SampleRecording(float fTime, FVector& OutLocation, FRotator& OutRotation, float& OutFieldOfView, FName& OutCameraId) const;
+
+	/// <summary>
+	/// Returns the camera switches recorded in a world time range.
+	/// </summary>
+	/// <param name="fStartTime">Range start.</param>
+	/// <param name="fEndTime">Range end.</param>
+	/// <param name="OutSwitches">Camera switches, in time order.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns the camera switches recorded in a world time range."))
+	void GetRecordedSwitches(float fStartTime, float fEndTime, TArray<FFixedCameraRecordedSwitch>& OutSwitches) const;
+
+	/// <summary>
+	/// Returns the bytes used by the recorded frames.
+	/// </summary>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns the bytes used by the recorded frames."))
+	int32 GetRecordingSize() const;
+
+	/// <summary>
+	/// Called by zone graphs when the player enters another zone.
+	/// </summary>
+	/// <param name="ZoneGraph">Zone graph.</param>
+	/// <param name="PreviousZone">Left zone (INDEX_NONE on the first zone).</param>
+	/// <param name="NextZone">Entered zone.</param>
+	void NotifyZoneChanged(AFixedCameraZoneGraph* ZoneGraph, int32 PreviousZone, int32 NextZone);
+
+	/// <summary>
+	/// Returns the last activated fixed camera.
+	/// </summary>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns the last activated fixed camera."))
+	AFixedCameraActor* GetActiveCamera() const;
+
+	/// <summary>
+	/// Returns every registered fixed camera.
+	/// </summary>
+	const TArray<AFixedCameraActor*>& GetCameras() const { return Cameras; }
+
+	/// <summary>
+	/// Returns true if geometry is between the active camera and the player (one frame latency).
+	/// </summary>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns true if geometry is between the active camera and the player (one frame latency)."))
+	bool IsPlayerOccluded() const;
+
+	/// <summary>
+	/// Returns true if geometry is between the active camera and its focus target (one frame latency).
+	/// </summary>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns true if geometry is between the active camera and its focus target (one frame latency)."))
+	bool IsFocusTargetOccluded() const;
+
+	/// <summary>
+	/// Returns the actors blocking the view of the player and the focus target.
+	/// </summary>
+	/// <param name="OutOccluders">Occluding actors.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns the actors blocking the view of the player and the focus target."))
+	void GetOccluders(TArray<AActor*>& OutOccluders) const;
+
+	/// <summary>
+	/// Returns the registered camera with the given identifier.
+	/// </summary>
+	/// <param name="CameraId">Camera identifier.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns the registered camera with the given identifier."))
+	AFixedCameraActor* FindCameraById(FName CameraId) const;
+
+	/// <summary>
+	/// Returns the cameras with an actor tag.
+	/// </summary>
+	/// <param name="Tag">Actor tag.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns the cameras with an actor tag."))
+	TArray<AFixedCameraActor*> FindCamerasByTag(FName Tag) const;
+
+	/// <summary>
+	/// Returns the camera of a zone graph zone, or nullptr if no zone has this name.
+	/// </summary>
+	/// <param name="ZoneName">Zone name.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns the camera of a zone graph zone, or nullptr if no zone has this name."))
+	AFixedCameraActor* FindCameraByZone(FName ZoneName) const;
+
+	/// <summary>
+	/// Returns the cached frustum of a camera (the active camera if None), or nullptr if the camera does not exist.
+	/// </summary>
+	/// <param name="CameraId">Camera identifier.</param>
+	const FFixedCameraFrustum* GetViewFrustum(FName CameraId = NAME_None) const;
+
+	/// <summary>
+	/// Returns true if the point is inside the view of a camera (the active camera if None).
+	/// </summary>
+	/// <param name="Point">World location.</param>
+	/// <param name="CameraId">Camera identifier.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns true if the point is inside the view of a camera (the active camera if None)."))
+	bool IsPointInView(const FVector& Point, FName CameraId = NAME_None) const;
+
+	/// <summary>
+	/// Returns true if the sphere intersects the view of a camera (the active camera if None).
+	/// </summary>
+	/// <param name="Center">Sphere center.</param>
+	/// <param name="Radius">Sphere radius.</param>
+	/// <param name="CameraId">Camera identifier.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns true if the sphere intersects the view of a camera (the active camera if None)."))
+	bool IsSphereInView(const FVector& Center, float Radius, FName CameraId = NAME_None) const;
+
+	/// <summary>
+	/// Returns true if the box intersects the view of a camera (the active camera if None).
+	/// </summary>
+	/// <param name="Box">World box.</param>
+	/// <param name="CameraId">Camera identifier.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns true if the box intersects the view of a camera (the active camera if None)."))
+	bool IsBoxInView(const FBox& Box, FName CameraId = NAME_None) const;
+
+	/// <summary>
+	/// Batched point test against the view of a camera (the active camera if None). Results are false if the camera does not exist.
+	/// </summary>
+	/// <param name="Points">World locations.</param>
+	/// <param name="OutInView">Result per point. Must have the same size as Points.</param>
+	/// <param name="CameraId">Camera identifier.</param>
+	void ArePointsInView(TArrayView<const FVector> Points, TArrayView<bool> OutInView, FName CameraId = NAME_None) const;
+
+	/// <summary>
+	/// Batched sphere test against the view of a camera (the active camera if None). Results are false if the camera does not exist.
+	/// </summary>
+	/// <param name="Centers">Sphere centers.</param>
+	/// <param name="Radii">Sphere radii.</param>
+	/// <param name="OutInView">Result per sphere. Must have the same size as Centers.</param>
+	/// <param name="CameraId">Camera identifier.</param>
+	void AreSpheresInView(TArrayView<const FVector> Centers, TArrayView<const float> Radii, TArrayView<bool> OutInView, FName CameraId = NAME_None) const;
+
+	/// <summary>
+	/// Batched box test against the view of a camera (the active camera if None). Results are false if the camera does not exist.
+	/// </summary>
+	/// <param name="Boxes">World boxes.</param>
+	/// <param name="OutInView">Result per box. Must have the same size as Boxes.</param>
+	/// <param name="CameraId">Camera identifier.</param>
+	void AreBoxesInView(TArrayView<const FBox> Boxes, TArrayView<bool> OutInView, FName CameraId = NAME_None) const;
+
+	/// <summary>
+	/// Registers a zone graph (called on BeginPlay).
+	/// </summary>
+	/// <param name="ZoneGraph">Zone graph.</param>
+	void RegisterZoneGraph(AFixedCameraZoneGraph* ZoneGraph);
+
+	/// <summary>
+	/// Unregisters a zone graph (called on EndPlay).
+	/// </summary>
+	/// <param name="ZoneGraph">Zone graph.</param>
+	void UnregisterZoneGraph(AFixedCameraZoneGraph* ZoneGraph);
+
+	/// <summary>
+	/// Registers a trigger (called on BeginPlay).
+	/// </summary>
+	/// <param name="Trigger">Fixed camera trigger.</param>
+	void RegisterTrigger(AFixedCameraTrigger* Trigger);
+
+	/// <summary>
+	/// Unregisters a trigger (called on EndPlay).
+	/// </summary>
+	/// <param name="Trigger">Fixed camera trigger.</param>
+	void UnregisterTrigger(AFixedCameraTrigger* Trigger);
+
+	/// <summary>
+	/// Returns the cameras reachable from the active camera.
+	/// </summary>
+	const TArray<AFixedCameraActor*>& GetUpcomingCameras() const { return UpcomingCameras; }
+
+	/// <summary>
+	/// Registers a significance component (called on BeginPlay).
+	/// </summary>
+	/// <param name="Component">Significance component.</param>
+	void RegisterSignificanceComponent(UFixedCameraSignificanceComponent* Component);
+
+	/// <summary>
+	/// Unregisters a significance component (called on EndPlay).
+	/// </summary>
+	/// <param name="Component">Significance component.</param>
+	void UnregisterSignificanceComponent(UFixedCameraSignificanceComponent* Component);
+
+	/// <summary>
+	/// Returns the cameras reachable from a camera through every zone graph and trigger.
+	/// </summary>
+	/// <param name="Camera">Fixed camera.</param>
+	/// <param name="OutCameras">Adjacent cameras.</param>
+	void GetAdjacentCameras(const AFixedCameraActor* Camera, TArray<AFixedCameraActor*>& OutCameras) const;
+
+	/// <summary>
+	/// Builds the current view frustum of a fixed camera.
+	/// </summary>
+	/// <param name="Camera">Fixed camera.</param>
+	/// <param name="OutFrustum">View frustum.</param>
+	static void GetCameraFrustum(const AFixedCameraActor* Camera, FConvexVolume& OutFrustum);
+
+	/// <summary>
+	/// Restores the faded occluders.
+	/// </summary>
+	virtual void Deinitialize() override;
+
+#if ENGINE_MAJOR_VERSION >= 5
+	/// <summary>
+	/// Registers every camera and zone graph of the world at once, before their BeginPlay.
+	/// </summary>
+	/// <param name="InWorld">World.</param>
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+#endif
+
+	/// <summary>
+	/// Called every frame.
+	/// </summary>
+	/// <param name="DeltaTime">Time between frames.</param>
+	virtual void Tick(float DeltaTime) override;
+
+	/// <summary>
+	/// Never ticks the class default object, the other instances ask IsTickable every frame.
+	/// </summary>
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	/// <summary>
+	/// Only the subsystems of game worlds tick.
+	/// </summary>
+	virtual bool IsTickable() const override;
+
+	/// <summary>
+	/// Returns the world of the subsystem, so it only ticks with that world.
+	/// </summary>
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/// <summary>
+	/// Returns the stat used to profile the tick of the subsystem.
+	/// </summary>
+	virtual TStatId GetStatId() const override;
+
+private:
+	/// <summary>
+	/// Consumes last frame occlusion traces and issues the new ones (called every frame).
+	/// </summary>
+	void UpdateOcclusion();
+
+	/// <summary>
+	/// Records the camera view computed by the player camera manager this frame (called after the actors tick while recording).
+	/// </summary>
+	/// <param name="InWorld">Ticked world.</param>
+	/// <param name="TickType">Tick type.</param>
+	/// <param name="DeltaTime">Time between frames.</param>
+	void RecordCameraView(UWorld* InWorld, ELevelTick TickType, float DeltaTime);
+
+	/// <summary>
+	/// Sets the target of an occlusion trace, clearing its state when the target changes.
+	/// </summary>
+	/// <param name="Trace">Occlusion trace.</param>
+	/// <param name="Target">New target.</param>
+	void SetOcclusionTarget(FFixedCameraOcclusionTrace& Trace, AActor* Target);
+
+	/// <summary>
+	/// Enables the streaming sources and loads the sublevels of the active, blending out and upcoming cameras.
+	/// Everything else owned by the cameras is disabled or unloaded.
+	/// </summary>
+	void ApplyCameraStreaming();
+
+	/// <summary>
+	/// Gathers the cameras reachable from the active camera and prefetches the new ones.
+	/// </summary>
+	void UpdateUpcomingCameras();
+
+	/// <summary>
+	/// Registers the upcoming cameras as additional streaming views (called every frame).
+	/// </summary>
+	void AddUpcomingStreamingViews();
+
+	/// <summary>
+	/// Prefetches the content seen by a camera that just became upcoming.
+	/// </summary>
+	/// <param name="Camera">Upcoming camera.</param>
+	void PrefetchCamera(AFixedCameraActor* Camera);
+
+	/// <summary>
+	/// Adds a camera as a streaming view origin.
+	/// </summary>
+	/// <param name="Camera">Fixed camera.</param>
+	/// <param name="fDuration">Seconds the view is kept (0 for this frame only).</param>
+	static void AddStreamingView(const AFixedCameraActor* Camera, float fDuration);
+
+	/// <summary>
+	/// Caches the zones and adjacent frustums of the active camera.
+	/// </summary>
+	void CacheSignificanceViews();
+
+	/// <summary>
+	/// Updates the significance of every registered component.
+	/// </summary>
+	void UpdateSignificance();
+
+	/// <summary>
+	/// Shows the actors of the given cameras and hides the rest of the managed actors.
+	/// </summary>
+	/// <param name="VisibleCameras">Cameras whose visibility sets are shown.</param>
+	void ApplyVisibilitySets(const TArray<AFixedCameraActor*>& VisibleCameras);
+};
@@ -4,14 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
-#include "Templates/SubclassOf.h"
-#include "Styling/SlateStyle.h"
+
+FIXEDCAMERASYSTEM_API DECLARE_LOG_CATEGORY_EXTERN(LogFixedCameraSystem, Log, All);
 
 class FFixedCameraSystemModule : public IModuleInterface
 {
 public:
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
-
-	TSharedPtr<FSlateStyleSet> StyleSet;
-};
\ No newline at end of file
+};
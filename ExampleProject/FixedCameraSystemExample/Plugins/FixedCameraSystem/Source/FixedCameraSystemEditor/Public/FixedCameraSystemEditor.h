@@ -0,0 +1,46 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+#include "Templates/SubclassOf.h"
+#include "Styling/SlateStyle.h"
+#include "Engine/StreamableManager.h"
+
+class FFixedCameraSystemEditorModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+	TSharedPtr<FSlateStyleSet> StyleSet;
+
+private:
+	/// <summary>
+	/// Starts loading the placeable blueprints the first time the category is opened.
+	/// </summary>
+	/// <param name="CategoryName">Refreshed placement category.</param>
+	void OnPlacementCategoryRefreshed(FName CategoryName);
+
+	/// <summary>
+	/// Registers the loaded blueprints as placeable items.
+	/// </summary>
+	void RegisterPlaceableItems();
+
+	/// <summary>
+	/// Loads the placeable blueprints in the background.
+	/// </summary>
+	FStreamableManager StreamableManager;
+	TSharedPtr<FStreamableHandle> PlaceableItemsHandle;
+
+	/// <summary>
+	/// Placement category refresh binding, removed once the items are requested.
+	/// </summary>
+	FDelegateHandle CategoryRefreshedHandle;
+
+	/// <summary>
+	/// Time the blueprints were requested, to log the load duration.
+	/// </summary>
+	double fLoadStartTime = 0.0;
+};
@@ -26,6 +26,8 @@ public class FixedCameraSystem : ModuleRules
 			new string[]
 			{
 				"Core",
+				"CoreUObject",
+				"Engine",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -34,14 +36,9 @@ public class FixedCameraSystem : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"Projects",
-				"InputCore",
-				"UnrealEd",
-				"ToolMenus",
-				"CoreUObject",
-				"Engine",
-				"Slate",
-				"SlateCore",
+				"NavigationSystem",
+				"Chaos",
+				"PhysicsCore",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -2,6 +2,8 @@
 
 #include "FixedCameraActor.h"
 
+#include "FixedCameraSystem.h"
+#include "FixedCameraSubsystem.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -13,6 +15,12 @@
 #include "Math/Rotator.h"
 #include "Math/UnrealMathVectorCommon.h"
 #include "Math/Quat.h"
+#include "EngineUtils.h"
+#include "Async/ParallelFor.h"
+#include "Runtime/Launch/Resources/Version.h"
+#if ENGINE_MAJOR_VERSION >= 5
+#include "Components/WorldPartitionStreamingSourceComponent.h"
+#endif
 
 #define LOCTEXT_NAMESPACE "FixedCameraSystem"
 
@@ -28,6 +36,10 @@ AFixedCameraActor::AFixedCameraActor()
 	RootComponent = Camera;
 
 	SetActorTickEnabled(false);
+
+	bInitialized = false;
+	bValidSettings = false;
+	bSnapView = false;
 }
 
 /// <summary>
@@ -38,12 +50,62 @@ void AFixedCameraActor::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
 
+	// Previews the resolved field of view.
+	ApplySettings();
+
 	if (CameraType == ECameraType::Rail && CameraRail)
 	{
 		SetActorLocation(CameraRail->GetInitialLocation());
 	}
 }
 
+/// <summary>
+/// Moves the settings saved before the profile overrides into them.
+/// </summary>
+void AFixedCameraActor::PostLoad()
+{
+	Super::PostLoad();
+
+#if WITH_EDITORONLY_DATA
+	// Without a profile every setting of the camera was used, with a profile only the overridden ones.
+	// Unchanged settings were not saved, so they still hold the defaults and are skipped.
+	const FFixedCameraProfileOverrides Defaults;
+	const bool bOwnSettings = Profile == nullptr;
+
+	auto MigrateSetting = [](auto& DeprecatedValue, auto& Value, const auto& DefaultValue)
+	{
+		if (DeprecatedValue == DefaultValue)
+			return false;
+
+		Value = DeprecatedValue;
+		DeprecatedValue = DefaultValue;
+		return true;
+	};
+
+	if (MigrateSetting(fRailTravellingDistance_DEPRECATED, ProfileOverrides.fRailTravellingDistance, Defaults.fRailTravellingDistance) && bOwnSettings)
+		ProfileOverrides.bOverride_fRailTravellingDistance = true;
+	if (MigrateSetting(bSmoothMovement_DEPRECATED, ProfileOverrides.bSmoothMovement, Defaults.bSmoothMovement) && bOwnSettings)
+		ProfileOverrides.bOverride_bSmoothMovement = true;
+	if (MigrateSetting(fSmoothMovementSpeed_DEPRECATED, ProfileOverrides.fSmoothMovementSpeed, Defaults.fSmoothMovementSpeed) && bOwnSettings)
+		ProfileOverrides.bOverride_fSmoothMovementSpeed = true;
+	if (MigrateSetting(CameraFocus_DEPRECATED, ProfileOverrides.CameraFocus, Defaults.CameraFocus) && bOwnSettings)
+		ProfileOverrides.bOverride_CameraFocus = true;
+	if (MigrateSetting(fMiddlePointAlpha_DEPRECATED, ProfileOverrides.fMiddlePointAlpha, Defaults.fMiddlePointAlpha) && bOwnSettings)
+		ProfileOverrides.bOverride_fMiddlePointAlpha = true;
+	if (MigrateSetting(bSmoothRotation_DEPRECATED, ProfileOverrides.bSmoothRotation, Defaults.bSmoothRotation) && bOwnSettings)
+		ProfileOverrides.bOverride_bSmoothRotation = true;
+	if (MigrateSetting(fSmoothRotationSpeed_DEPRECATED, ProfileOverrides.fSmoothRotationSpeed, Defaults.fSmoothRotationSpeed) && bOwnSettings)
+		ProfileOverrides.bOverride_fSmoothRotationSpeed = true;
+
+	// The field of view was read from the camera component.
+	if (Camera && (bOwnSettings || ProfileOverrides.bOverride_fFieldOfView) && Camera->FieldOfView != Defaults.fFieldOfView)
+	{
+		ProfileOverrides.fFieldOfView = Camera->FieldOfView;
+		ProfileOverrides.bOverride_fFieldOfView = true;
+	}
+#endif
+}
+
 /// <summary>
 /// Called when the game starts or when spawned
 /// </summary>
@@ -51,19 +113,142 @@ void AFixedCameraActor::BeginPlay()
 {
 	Super::BeginPlay();
 
-	PlayerCharacterActorReference = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
-	
+	// Everything else is initialized when the camera is first activated.
 	SetActorTickEnabled(false);
 
-	if (bDefaultCamera) 
+	// The settings are resolved and validated on registration, which may have been done on world begin play.
+	UFixedCameraSubsystem* FixedCameraSubsystem = GetWorld()->GetSubsystem<UFixedCameraSubsystem>();
+	FixedCameraSubsystem->RegisterCamera(this);
+
+	if (bDefaultCamera && InitializeFixedCamera()) 
 	{
 		Cast<APlayerController>(UGameplayStatics::GetPlayerController(GetWorld(), 0))->SetViewTarget(this);
 		Camera->SetActive(true);
+		SetActorTickEnabled(true);
+		FixedCameraSubsystem->NotifyCameraActivated(this, 0.f);
 	}
 	else 
 	{ 
 		Camera->SetActive(false); 
 	}
+}
+
+/// <summary>
+/// Called when the actor is removed from the level.
+/// </summary>
+/// <param name="EndPlayReason">End play reason.</param>
+void AFixedCameraActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UFixedCameraSubsystem* FixedCameraSubsystem = GetWorld()->GetSubsystem<UFixedCameraSubsystem>())
+		FixedCameraSubsystem->UnregisterCamera(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+/// <summary>
+/// Called every frame.
+/// </summary>
+/// <param name="DeltaTime">Time between frames.</param>
+void AFixedCameraActor::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Find player in case that the reference is not set.
+	if (!PlayerCharacterActorReference) 
+	{
+		PlayerCharacterActorReference = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+		return;
+	}
+
+	const bool bSnap = bSnapView;
+	bSnapView = false;
+		
+	// Calculate rail movement.
+	if (CameraType == ECameraType::Rail) 
+	{
+		if (Settings.bSmoothMovement && !bSnap)
+			SetActorLocation(FMath::Lerp(GetActorLocation(), CameraRail->GetLocationAlongRail(CameraRail->GetRailLength() * FMath::Clamp(FVector::Distance(PlayerCharacterActorReference->GetActorLocation(), GetActorLocation()) / Settings.fRailTravellingDistance, 0.f, 1.f)), GetWorld()->GetDeltaSeconds() * Settings.fSmoothMovementSpeed));
+		else
+			SetActorLocation(CameraRail->GetLocationAlongRail(CameraRail->GetRailLength() * FMath::Clamp(FVector::Distance(PlayerCharacterActorReference->GetActorLocation(), GetActorLocation()) / Settings.fRailTravellingDistance, 0.f, 1.f)));
+	}
+
+	// Stop event if no focus is selected.
+	if (Settings.CameraFocus == ECameraFocus::NoFocus)
+	{
+		return;
+	}
+
+	FRotator targetRotation;
+
+	// Calculate rotation.
+	switch (Settings.CameraFocus) 
+	{
+		case ECameraFocus::FocusOnPlayer:
+			targetRotation = UKismetMathLibrary::FindLookAtRotation(Camera->GetComponentLocation(), PlayerCharacterActorReference->GetActorLocation());
+			break;
+		case ECameraFocus::FocusOnObject:
+			targetRotation = UKismetMathLibrary::FindLookAtRotation(Camera->GetComponentLocation(), FocusTarget->GetActorLocation());
+			break;
+		case ECameraFocus::MiddleLocationPlayerAndInitialFocus:
+			targetRotation = FRotator(FQuat::Slerp(FQuat(originalCameraRotation), FQuat(UKismetMathLibrary::FindLookAtRotation(Camera->GetComponentLocation(), PlayerCharacterActorReference->GetActorLocation())), Settings.fMiddlePointAlpha));
+			break;
+		case ECameraFocus::MiddleLocationPlayerAndObject:
+			targetRotation = FRotator(FQuat::Slerp(FQuat(UKismetMathLibrary::FindLookAtRotation(Camera->GetComponentLocation(), FocusTarget->GetActorLocation())), FQuat(UKismetMathLibrary::FindLookAtRotation(Camera->GetComponentLocation(), PlayerCharacterActorReference->GetActorLocation())), Settings.fMiddlePointAlpha));
+			break;
+		case ECameraFocus::FocusOnGroup:
+		{
+			if (Settings.bIncludePlayerInGroup)
+				GroupBounds.Add(PlayerCharacterActorReference);
+
+			FVector GroupCenter;
+			float fGroupRadius;
+			if (!GroupBounds.Compute(GroupCenter, fGroupRadius))
+				return;
+
+			targetRotation = UKismetMathLibrary::FindLookAtRotation(Camera->GetComponentLocation(), GroupCenter);
+
+			if (Settings.bFitGroupInView)
+			{
+				// Half angle that contains the group sphere, converted to the horizontal field of view.
+				const float fDistance = FMath::Max(FVector::Distance(Camera->GetComponentLocation(), GroupCenter), 1.f);
+				const float fHalfAngle = FMath::Asin(FMath::Clamp(fGroupRadius * Settings.fGroupFramingPadding / fDistance, 0.f, 0.99f));
+				const float fAspectRatio = FMath::Max(Camera->AspectRatio, 1.f);
+				const float fTargetFOV = FMath::Clamp(FMath::RadiansToDegrees(2.f * FMath::Atan(FMath::Tan(fHalfAngle) * fAspectRatio)), Settings.fMinGroupFieldOfView, Settings.fFieldOfView);
+
+				Camera->SetFieldOfView(Settings.bSmoothRotation && !bSnap ? FMath::FInterpTo(Camera->FieldOfView, fTargetFOV, GetWorld()->GetDeltaSeconds(), Settings.fSmoothRotationSpeed) : fTargetFOV);
+			}
+			break;
+		}
+		default:
+			break;
+	}
+
+	// Screen-space composition: the transform is only written when the focus point leaves the dead zone.
+	if (Settings.bUseDeadZone && !bSnap)
+	{
+		FRotator ComposedRotation;
+		if (ComposeDeadZone(targetRotation.Vector(), ComposedRotation))
+			Camera->SetWorldRotation(ComposedRotation);
+		return;
+	}
+
+	// Rotation smoothness.
+	if (Settings.bSmoothRotation && !bSnap)
+		Camera->SetWorldRotation(FMath::Lerp(Camera->GetComponentRotation(), targetRotation, GetWorld()->GetDeltaSeconds() * Settings.fSmoothRotationSpeed));
+	else
+		Camera->SetWorldRotation(targetRotation);
+}
+#pragma endregion
+
+#pragma region CLASS_EVENTS
+/// <summary>
+/// Resolves the settings and checks the references they need. Shows an error and quits the game if one is missing. Called on registration.
+/// </summary>
+/// <returns>False if the camera settings are not valid.</returns>
+bool AFixedCameraActor::ValidateFixedCamera()
+{
+	ApplySettings();
+	bValidSettings = false;
 
 	FText DialogText;
 
@@ -79,14 +264,14 @@ void AFixedCameraActor::BeginPlay()
 			);
 			FMessageDialog::Open(EAppMsgType::Ok, DialogText);
 			UKismetSystemLibrary::QuitGame(GetWorld(), UGameplayStatics::GetPlayerController(GetWorld(), 0), EQuitPreference::Quit, false);
-			return;
+			return false;
 		}
 		break;
 	default:
 		break;
 	}
 
-	switch (CameraFocus)
+	switch (Settings.CameraFocus)
 	{
 	case ECameraFocus::FocusOnObject:
 		if (!FocusTarget)
@@ -98,7 +283,7 @@ void AFixedCameraActor::BeginPlay()
 			);
 			FMessageDialog::Open(EAppMsgType::Ok, DialogText);
 			UKismetSystemLibrary::QuitGame(GetWorld(), UGameplayStatics::GetPlayerController(GetWorld(), 0), EQuitPreference::Quit, false);
-			return;
+			return false;
 		}
 		break;
 	case ECameraFocus::MiddleLocationPlayerAndObject:
@@ -111,77 +296,98 @@ void AFixedCameraActor::BeginPlay()
 			);
 			FMessageDialog::Open(EAppMsgType::Ok, DialogText);
 			UKismetSystemLibrary::QuitGame(GetWorld(), UGameplayStatics::GetPlayerController(GetWorld(), 0), EQuitPreference::Quit, false);
-			return;
+			return false;
 		}
 		break;
 	default:
 		break;
 	}
 
-	SetActorTickEnabled(true);
+	bValidSettings = true;
+	return true;
+}
+
+/// <summary>
+/// Looks up the player and prepares the focus. Called on first activation.
+/// </summary>
+/// <returns>False if the camera settings are not valid.</returns>
+bool AFixedCameraActor::InitializeFixedCamera()
+{
+	if (bInitialized)
+		return true;
+
+	if (!bValidSettings)
+		return false;
+
+	PlayerCharacterActorReference = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+
+	for (AActor* Member : FocusGroup)
+		GroupBounds.Add(Member);
+
 	originalCameraRotation = Camera->GetComponentRotation();
+
+	// The camera did not follow the player while inactive, so the first update is not smoothed.
+	bSnapView = true;
+	bInitialized = true;
+	return true;
 }
 
 /// <summary>
-/// Called every frame.
+/// Clears the first activation state and resolves the settings again, so the camera can be reused with other settings.
 /// </summary>
-/// <param name="DeltaTime">Time between frames.</param>
-void AFixedCameraActor::Tick(float DeltaTime)
+void AFixedCameraActor::ResetFixedCamera()
 {
-	Super::Tick(DeltaTime);
+	SetActorTickEnabled(false);
+	Camera->SetActive(false);
 
-	// Find player in case that the reference is not set.
-	if (!PlayerCharacterActorReference) 
-	{
-		PlayerCharacterActorReference = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
-		return;
-	}
-		
-	// Calculate rail movement.
-	if (CameraType == ECameraType::Rail) 
-	{
-		if (bSmoothMovement)
-			SetActorLocation(FMath::Lerp(GetActorLocation(), CameraRail->GetLocationAlongRail(CameraRail->GetRailLength() * FMath::Clamp(FVector::Distance(PlayerCharacterActorReference->GetActorLocation(), GetActorLocation()) / fRailTravellingDistance, 0.f, 1.f)), GetWorld()->GetDeltaSeconds() * fSmoothMovementSpeed));
-		else
-			SetActorLocation(CameraRail->GetLocationAlongRail(CameraRail->GetRailLength() * FMath::Clamp(FVector::Distance(PlayerCharacterActorReference->GetActorLocation(), GetActorLocation()) / fRailTravellingDistance, 0.f, 1.f)));
-	}
+	// Also restores the field of view changed by the group framing or a restored view.
+	ApplySettings();
 
-	// Stop event if no focus is selected.
-	if (CameraFocus == ECameraFocus::NoFocus)
-	{
-		return;
-	}
+	if (CameraType == ECameraType::Rail && CameraRail)
+		SetActorLocation(CameraRail->GetInitialLocation());
 
-	FRotator targetRotation;
+	GroupBounds.Reset();
+	PlayerCharacterActorReference = nullptr;
+	bInitialized = false;
+	bValidSettings = false;
+	bSnapView = false;
+}
 
-	// Calculate rotation.
-	switch (CameraFocus) 
-	{
-		case ECameraFocus::FocusOnPlayer:
-			targetRotation = UKismetMathLibrary::FindLookAtRotation(Camera->GetComponentLocation(), PlayerCharacterActorReference->GetActorLocation());
-			break;
-		case ECameraFocus::FocusOnObject:
-			targetRotation = UKismetMathLibrary::FindLookAtRotation(Camera->GetComponentLocation(), FocusTarget->GetActorLocation());
-			break;
-		case ECameraFocus::MiddleLocationPlayerAndInitialFocus:
-			targetRotation = FRotator(FQuat::Slerp(FQuat(originalCameraRotation), FQuat(UKismetMathLibrary::FindLookAtRotation(Camera->GetComponentLocation(), PlayerCharacterActorReference->GetActorLocation())), fMiddlePointAlpha));
-			break;
-		case ECameraFocus::MiddleLocationPlayerAndObject:
-			targetRotation = FRotator(FQuat::Slerp(FQuat(UKismetMathLibrary::FindLookAtRotation(Camera->GetComponentLocation(), FocusTarget->GetActorLocation())), FQuat(UKismetMathLibrary::FindLookAtRotation(Camera->GetComponentLocation(), PlayerCharacterActorReference->GetActorLocation())), fMiddlePointAlpha));
-			break;
-		default:
-			break;
-	}
+/// <summary>
+/// Returns the position of the camera along its rail (0 = start, 1 = end, 0 for static cameras).
+/// </summary>
+float AFixedCameraActor::GetRailProgress() const
+{
+	if (CameraType != ECameraType::Rail || !CameraRail)
+		return 0.f;
 
-	// Rotation smoothness.
-	if (bSmoothRotation)
-		Camera->SetWorldRotation(FMath::Lerp(Camera->GetComponentRotation(), targetRotation, GetWorld()->GetDeltaSeconds() * fSmoothRotationSpeed));
-	else
-		Camera->SetWorldRotation(targetRotation);
+	const float fRailLength = CameraRail->GetRailLength();
+	return fRailLength > KINDA_SMALL_NUMBER ? FMath::Clamp(CameraRail->GetDistanceAlongRail(GetActorLocation()) / fRailLength, 0.f, 1.f) : 0.f;
+}
+
+/// <summary>
+/// Initializes the camera and places it at a saved view, so the next update continues from it without snapping.
+/// </summary>
+/// <param name="fRailProgress">Position along the rail (0 = start, 1 = end).</param>
+/// <param name="ViewRotation">Camera rotation.</param>
+/// <param name="fViewFieldOfView">Camera field of view.</param>
+/// <returns>False if the camera settings are not valid.</returns>
+bool AFixedCameraActor::RestoreFixedCameraView(float fRailProgress, const FRotator& ViewRotation, float fViewFieldOfView)
+{
+	if (!InitializeFixedCamera())
+		return false;
+
+	if (CameraType == ECameraType::Rail)
+		SetActorLocation(CameraRail->GetLocationAlongRail(CameraRail->GetRailLength() * FMath::Clamp(fRailProgress, 0.f, 1.f)));
+
+	Camera->SetWorldRotation(ViewRotation);
+	Camera->SetFieldOfView(fViewFieldOfView);
+
+	// The saved view is already converged, so the smoothing continues from it.
+	bSnapView = false;
+	return true;
 }
-#pragma endregion
 
-#pragma region CLASS_EVENTS
 /// <summary>
 /// Activates the camera actor.
 /// </summary>
@@ -190,9 +396,13 @@ void AFixedCameraActor::Tick(float DeltaTime)
 /// <param name="fBlendExponent">Smoothness blend exponent.</param>
 void AFixedCameraActor::ActivateFixedCamera(float fSmoothTransition, TEnumAsByte<EViewTargetBlendFunction> BlendFunction, float fBlendExponent)
 {
+	if (!InitializeFixedCamera())
+		return;
+
 	SetActorTickEnabled(true);
 	Camera->SetActive(true);
 	UGameplayStatics::GetPlayerController(this, 0)->SetViewTargetWithBlend(this, fSmoothTransition, BlendFunction, fBlendExponent);
+	GetWorld()->GetSubsystem<UFixedCameraSubsystem>()->NotifyCameraActivated(this, fSmoothTransition);
 }
 
 /// <summary>
@@ -205,4 +415,280 @@ void AFixedCameraActor::DeactivateFixedCamera()
 
 	Camera->SetActive(false);
 }
+
+/// <summary>
+/// Rotates the camera just enough to bring the focus direction back to the dead zone.
+/// </summary>
+/// <param name="FocusDirection">World direction to the focus point.</param>
+/// <param name="OutRotation">New camera rotation.</param>
+/// <returns>False if the focus point is inside the dead zone (no rotation update).</returns>
+bool AFixedCameraActor::ComposeDeadZone(const FVector& FocusDirection, FRotator& OutRotation) const
+{
+	const FRotator CurrentRotation = Camera->GetComponentRotation();
+	const FVector LocalDirection = CurrentRotation.UnrotateVector(FocusDirection);
+
+	// Behind the camera: aim directly.
+	if (LocalDirection.X <= KINDA_SMALL_NUMBER)
+	{
+		OutRotation = FocusDirection.Rotation();
+		return true;
+	}
+
+	// Normalized screen position of the focus point.
+	const float fTanHalfHorizontal = FMath::Tan(FMath::DegreesToRadians(Camera->FieldOfView * 0.5f));
+	const float fTanHalfVertical = fTanHalfHorizontal / FMath::Max(Camera->AspectRatio, KINDA_SMALL_NUMBER);
+	const float fScreenX = LocalDirection.Y / LocalDirection.X / fTanHalfHorizontal;
+	const float fScreenY = LocalDirection.Z / LocalDirection.X / fTanHalfVertical;
+
+	if (FMath::Abs(fScreenX) <= Settings.DeadZone.X && FMath::Abs(fScreenY) <= Settings.DeadZone.Y)
+		return false;
+
+	// Angle between the focus point and the edge of a zone, along one screen axis.
+	auto AngleToZone = [](float fScreen, float fZone, float fTanHalf)
+	{
+		return FMath::RadiansToDegrees(FMath::Atan(fScreen * fTanHalf) - FMath::Atan(FMath::Clamp(fScreen, -fZone, fZone) * fTanHalf));
+	};
+
+	// Beyond the soft zone is corrected at once, the rest is damped.
+	const float fAlpha = Settings.bSmoothRotation ? FMath::Clamp(GetWorld()->GetDeltaSeconds() * Settings.fSmoothRotationSpeed, 0.f, 1.f) : 1.f;
+	const float fHardYaw = AngleToZone(fScreenX, FMath::Max(Settings.SoftZone.X, Settings.DeadZone.X), fTanHalfHorizontal);
+	const float fHardPitch = AngleToZone(fScreenY, FMath::Max(Settings.SoftZone.Y, Settings.DeadZone.Y), fTanHalfVertical);
+	const float fYaw = FMath::Lerp(fHardYaw, AngleToZone(fScreenX, Settings.DeadZone.X, fTanHalfHorizontal), fAlpha);
+	const float fPitch = FMath::Lerp(fHardPitch, AngleToZone(fScreenY, Settings.DeadZone.Y, fTanHalfVertical), fAlpha);
+
+	OutRotation = FRotator(FMath::Clamp(CurrentRotation.Pitch + fPitch, -89.f, 89.f), CurrentRotation.Yaw + fYaw, CurrentRotation.Roll);
+	return true;
+}
+
+/// <summary>
+/// Returns the camera identifier (the actor name if no Camera ID is set).
+/// </summary>
+FName AFixedCameraActor::GetCameraId() const
+{
+	return CameraId.IsNone() ? GetFName() : CameraId;
+}
+
+/// <summary>
+/// Returns the resolved focus type.
+/// </summary>
+ECameraFocus AFixedCameraActor::GetCameraFocus() const
+{
+	// Same value as the one read by Tick once play has begun.
+	if (HasActorBegunPlay())
+		return Settings.CameraFocus;
+
+	FFixedCameraSettings ResolvedSettings;
+	ResolveSettings(ResolvedSettings);
+	return ResolvedSettings.CameraFocus;
+}
+
+/// <summary>
+/// Replaces the profile and resolves the settings again.
+/// </summary>
+/// <param name="NewProfile">Shared settings asset (none uses the default settings).</param>
+void AFixedCameraActor::SetProfile(UFixedCameraProfile* NewProfile)
+{
+	Profile = NewProfile;
+	ApplySettings();
+}
+
+/// <summary>
+/// Replaces the overridden settings and resolves the settings again.
+/// </summary>
+/// <param name="NewProfileOverrides">Settings that replace the ones of the profile.</param>
+void AFixedCameraActor::SetProfileOverrides(const FFixedCameraProfileOverrides& NewProfileOverrides)
+{
+	ProfileOverrides = NewProfileOverrides;
+	ApplySettings();
+}
+
+/// <summary>
+/// Fills the settings from the defaults or the profile, then from the overrides.
+/// </summary>
+/// <param name="OutSettings">Resolved settings.</param>
+void AFixedCameraActor::ResolveSettings(FFixedCameraSettings& OutSettings) const
+{
+	OutSettings = FFixedCameraSettings();
+
+	if (Profile)
+		Profile->GetSettings(OutSettings);
+
+	ProfileOverrides.ApplyTo(OutSettings);
+}
+
+/// <summary>
+/// Resolves the settings and applies their field of view to the camera.
+/// </summary>
+void AFixedCameraActor::ApplySettings()
+{
+	ResolveSettings(Settings);
+	Camera->SetFieldOfView(Settings.fFieldOfView);
+}
+
+/// <summary>
+/// Adds an actor to the framed group.
+/// </summary>
+/// <param name="Actor">New member.</param>
+void AFixedCameraActor::AddToFocusGroup(AActor* Actor)
+{
+	GroupBounds.Add(Actor);
+}
+
+/// <summary>
+/// Removes an actor from the framed group.
+/// </summary>
+/// <param name="Actor">Member.</param>
+void AFixedCameraActor::RemoveFromFocusGroup(AActor* Actor)
+{
+	GroupBounds.Remove(Actor);
+}
+
+/// <summary>
+/// Enables or disables the World Partition streaming source of the camera (no-op before UE5).
+/// </summary>
+/// <param name="bEnabled">Streams around the camera view.</param>
+void AFixedCameraActor::SetStreamingSourceEnabled(bool bEnabled)
+{
+#if ENGINE_MAJOR_VERSION >= 5
+	UWorldPartitionStreamingSourceComponent* StreamingSource = Cast<UWorldPartitionStreamingSourceComponent>(StreamingSourceComponent);
+
+	if (!StreamingSource)
+	{
+		if (!bEnabled)
+			return;
+
+		StreamingSource = NewObject<UWorldPartitionStreamingSourceComponent>(this, TEXT("StreamingSource"));
+		StreamingSource->DisableStreamingSource();
+#if ENGINE_MINOR_VERSION >= 1
+		// Only what the camera sees is streamed, not a radius around it.
+		FStreamingSourceShape Shape;
+		Shape.bUseGridLoadingRange = false;
+		Shape.LoadingRange = fStreamingSourceRange;
+		Shape.bIsSector = true;
+		Shape.SectorAngle = FMath::Clamp(Camera->FieldOfView, 1.f, 360.f);
+		StreamingSource->Shapes.Add(Shape);
+#endif
+		StreamingSource->RegisterComponent();
+		StreamingSourceComponent = StreamingSource;
+	}
+
+	if (bEnabled)
+		StreamingSource->EnableStreamingSource();
+	else
+		StreamingSource->DisableStreamingSource();
+#endif
+}
+
+#if WITH_EDITOR
+/// <summary>
+/// Traces the bounds of every static actor from the camera (or along its rail) and stores the ones that can be visible.
+/// </summary>
+void AFixedCameraActor::BakeVisibilitySet()
+{
+	const double StartTime = FPlatformTime::Seconds();
+	UWorld* World = GetWorld();
+
+	// Viewpoints: the camera itself or samples along its rail.
+	TArray<FVector> Viewpoints;
+	if (CameraType == ECameraType::Rail && CameraRail)
+	{
+		// ClampMin is only enforced in the editor details panel.
+		const int32 NumSamples = FMath::Max(RailVisibilitySamples, 2);
+		for (int32 Sample = 0; Sample < NumSamples; Sample++)
+			Viewpoints.Add(CameraRail->GetLocationAlongRail(CameraRail->GetRailLength() * Sample / (NumSamples - 1)));
+	}
+	else
+	{
+		Viewpoints.Add(Camera->GetComponentLocation());
+	}
+
+	// Only static actors can be baked.
+	TArray<AActor*> Candidates;
+	TArray<FBox> CandidateBounds;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AActor* Actor = *It;
+		const USceneComponent* ActorRoot = Actor->GetRootComponent();
+		if (Actor == this || !ActorRoot || ActorRoot->Mobility != EComponentMobility::Static)
+			continue;
+
+		const FBox Bounds = Actor->GetComponentsBoundingBox(true);
+		if (!Bounds.IsValid)
+			continue;
+
+		Candidates.Add(Actor);
+		CandidateBounds.Add(Bounds);
+	}
+
+	// Cameras without focus keep their rotation, so anything outside their view cone is discarded.
+	const bool bFixedRotation = GetCameraFocus() == ECameraFocus::NoFocus;
+	const FVector Forward = Camera->GetForwardVector();
+	const float TanHalfFOV = FMath::Tan(FMath::DegreesToRadians(Camera->FieldOfView * 0.5f));
+	const float HalfDiagonalFOV = FMath::Atan(TanHalfFOV * FMath::Sqrt(1.f + 1.f / FMath::Square(Camera->AspectRatio)));
+
+	TArray<uint8> Visible;
+	Visible.SetNumZeroed(Candidates.Num());
+
+	ParallelFor(Candidates.Num(), [&](int32 CandidateIndex)
+	{
+		const FBox& Bounds = CandidateBounds[CandidateIndex];
+		const FVector Center = Bounds.GetCenter();
+		const float Radius = Bounds.GetExtent().Size();
+
+		// Trace to the center and to the corners pulled slightly inwards.
+		TArray<FVector, TInlineAllocator<9>> TracePoints;
+		TracePoints.Add(Center);
+		for (int32 Corner = 0; Corner < 8; Corner++)
+		{
+			const FVector CornerOffset(
+				(Corner & 1) ? Bounds.GetExtent().X : -Bounds.GetExtent().X,
+				(Corner & 2) ? Bounds.GetExtent().Y : -Bounds.GetExtent().Y,
+				(Corner & 4) ? Bounds.GetExtent().Z : -Bounds.GetExtent().Z);
+			TracePoints.Add(Center + CornerOffset * 0.9f);
+		}
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FixedCameraVisibilitySet), false, this);
+
+		for (const FVector& Viewpoint : Viewpoints)
+		{
+			const FVector ToCenter = Center - Viewpoint;
+			const float Distance = ToCenter.Size();
+
+			if (Distance <= Radius)
+			{
+				Visible[CandidateIndex] = true;
+				return;
+			}
+
+			if (bFixedRotation)
+			{
+				const float Angle = FMath::Acos(FMath::Clamp(FVector::DotProduct(ToCenter / Distance, Forward), -1.f, 1.f));
+				if (Angle - FMath::Asin(Radius / Distance) > HalfDiagonalFOV)
+					continue;
+			}
+
+			for (const FVector& TracePoint : TracePoints)
+			{
+				FHitResult Hit;
+				if (!World->LineTraceSingleByChannel(Hit, Viewpoint, TracePoint, ECC_Visibility, QueryParams) || Hit.GetActor() == Candidates[CandidateIndex])
+				{
+					Visible[CandidateIndex] = true;
+					return;
+				}
+			}
+		}
+	});
+
+	Modify();
+	VisibilitySet.Reset();
+	for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); CandidateIndex++)
+	{
+		if (Visible[CandidateIndex])
+			VisibilitySet.Add(Candidates[CandidateIndex]);
+	}
+
+	UE_LOG(LogFixedCameraSystem, Log, TEXT("%s: %d of %d static actors visible from %d viewpoints (%.2f s)."),
+		*GetName(), VisibilitySet.Num(), Candidates.Num(), Viewpoints.Num(), FPlatformTime::Seconds() - StartTime);
+}
+#endif
 #pragma endregion
\ No newline at end of file
@@ -0,0 +1,349 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraCoverageMap.h"
+
+#include "FixedCameraSystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "EngineUtils.h"
+#include "Async/ParallelFor.h"
+#include "NavigationSystem.h"
+#include "NavMesh/RecastNavMesh.h"
+
+#pragma region UNREAL_ENGINE_EVENTS
+/// <summary>
+/// Sets default values for this actor's properties.
+/// </summary>
+AFixedCameraCoverageMap::AFixedCameraCoverageMap()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PostPhysics;
+
+	Root = CreateDefaultSubobject<USceneComponent>("Root Component");
+	RootComponent = Root;
+
+	GridOrigin = FVector::ZeroVector;
+	GridSizeX = 0;
+	GridSizeY = 0;
+	fBakedCellSize = 0.f;
+
+	CurrentCamera = INDEX_NONE;
+	PlayerCharacterActorReference = nullptr;
+}
+
+/// <summary>
+/// Called when the game starts or when spawned.
+/// </summary>
+void AFixedCameraCoverageMap::BeginPlay()
+{
+	Super::BeginPlay();
+
+	CurrentCamera = INDEX_NONE;
+	PlayerCharacterActorReference = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+
+	if (CellCameras.Num() == 0)
+	{
+		UE_LOG(LogFixedCameraSystem, Warning, TEXT("%s has no baked coverage data."), *GetName());
+		SetActorTickEnabled(false);
+	}
+}
+
+/// <summary>
+/// Called every frame.
+/// </summary>
+/// <param name="DeltaTime">Time between frames.</param>
+void AFixedCameraCoverageMap::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Find player in case that the reference is not set.
+	if (!PlayerCharacterActorReference)
+	{
+		PlayerCharacterActorReference = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+		return;
+	}
+
+	const int32 NewCamera = GetCameraIndexAtLocation(PlayerCharacterActorReference->GetActorLocation());
+	if (NewCamera == INDEX_NONE || NewCamera == CurrentCamera || !BakedCameras[NewCamera])
+	{
+		return;
+	}
+
+	const bool bFirstCamera = CurrentCamera == INDEX_NONE;
+
+	if (BakedCameras.IsValidIndex(CurrentCamera) && BakedCameras[CurrentCamera])
+		BakedCameras[CurrentCamera]->DeactivateFixedCamera();
+
+	CurrentCamera = NewCamera;
+
+	if (bFirstCamera)
+		BakedCameras[CurrentCamera]->ActivateFixedCamera(0.f, VTBlend_Linear, 0.f);
+	else
+		BakedCameras[CurrentCamera]->ActivateFixedCamera(fSmoothTransition, BlendFunc, fBlendExp);
+}
+#pragma endregion
+
+#pragma region CLASS_EVENTS
+/// <summary>
+/// Returns the camera covering a world location in O(1).
+/// </summary>
+/// <param name="Location">World location.</param>
+AFixedCameraActor* AFixedCameraCoverageMap::GetCameraAtLocation(const FVector& Location) const
+{
+	const int32 CameraIndex = GetCameraIndexAtLocation(Location);
+	return CameraIndex != INDEX_NONE ? BakedCameras[CameraIndex] : nullptr;
+}
+
+/// <summary>
+/// Returns the baked camera index of a world location.
+/// </summary>
+/// <param name="Location">World location.</param>
+int32 AFixedCameraCoverageMap::GetCameraIndexAtLocation(const FVector& Location) const
+{
+	if (fBakedCellSize <= 0.f)
+		return INDEX_NONE;
+
+	const int32 CellX = FMath::FloorToInt((Location.X - GridOrigin.X) / fBakedCellSize);
+	const int32 CellY = FMath::FloorToInt((Location.Y - GridOrigin.Y) / fBakedCellSize);
+
+	if (CellX < 0 || CellY < 0 || CellX >= GridSizeX || CellY >= GridSizeY)
+		return INDEX_NONE;
+
+	const uint16 CameraIndex = CellCameras[CellY * GridSizeX + CellX];
+	return CameraIndex != MAX_uint16 && BakedCameras.IsValidIndex(CameraIndex) ? CameraIndex : INDEX_NONE;
+}
+
+#if WITH_EDITOR
+/// <summary>
+/// Samples the walkable navmesh, scores every camera and writes the best one per cell.
+/// </summary>
+void AFixedCameraCoverageMap::BakeCoverage()
+{
+	UWorld* World = GetWorld();
+	UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	const ARecastNavMesh* NavMesh = NavigationSystem ? Cast<ARecastNavMesh>(NavigationSystem->GetDefaultNavDataInstance(FNavigationSystem::DontCreate)) : nullptr;
+
+	if (!NavMesh)
+	{
+		UE_LOG(LogFixedCameraSystem, Warning, TEXT("%s: coverage bake needs a built Recast navmesh."), *GetName());
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Gather candidate cameras.
+	TArray<AFixedCameraActor*> Cameras;
+	if (CandidateCameras.Num() > 0)
+	{
+		Cameras = CandidateCameras;
+	}
+	else
+	{
+		for (TActorIterator<AFixedCameraActor> It(World); It; ++It)
+			Cameras.Add(*It);
+	}
+	Cameras.RemoveAll([](const AFixedCameraActor* Camera) { return Camera == nullptr; });
+
+	if (Cameras.Num() == 0 || Cameras.Num() >= MAX_uint16)
+	{
+		UE_LOG(LogFixedCameraSystem, Warning, TEXT("%s: coverage bake needs between 1 and %d cameras, found %d."), *GetName(), MAX_uint16 - 1, Cameras.Num());
+		return;
+	}
+
+	// Sample walkable polygons.
+	TArray<FNavPoly> Polys;
+	NavMesh->GetPolysInBox(NavMesh->GetBounds(), Polys);
+
+	if (Polys.Num() == 0)
+	{
+		UE_LOG(LogFixedCameraSystem, Warning, TEXT("%s: the navmesh has no walkable polygons."), *GetName());
+		return;
+	}
+
+	// Polygon outlines, which also give the grid bounds so that walkable area near the navmesh border is covered.
+	TArray<TArray<FVector>> PolyVerts;
+	PolyVerts.SetNum(Polys.Num());
+
+	FBox SampleBounds(ForceInit);
+	for (int32 PolyIndex = 0; PolyIndex < Polys.Num(); PolyIndex++)
+	{
+		NavMesh->GetPolyVerts(Polys[PolyIndex].Ref, PolyVerts[PolyIndex]);
+		SampleBounds += Polys[PolyIndex].Center;
+		for (const FVector& Vert : PolyVerts[PolyIndex])
+			SampleBounds += Vert;
+	}
+
+	Modify();
+
+	fBakedCellSize = fCellSize;
+	GridOrigin = SampleBounds.Min;
+	GridSizeX = FMath::FloorToInt((SampleBounds.Max.X - SampleBounds.Min.X) / fBakedCellSize) + 1;
+	GridSizeY = FMath::FloorToInt((SampleBounds.Max.Y - SampleBounds.Min.Y) / fBakedCellSize) + 1;
+
+	TArray<FVector> SampleLocations;
+	TArray<int32> SampleCells;
+	SampleLocations.Reserve(Polys.Num());
+	SampleCells.Reserve(Polys.Num());
+
+	// Rasterize every polygon: one sample per cell center inside it, projected on the polygon plane.
+	for (int32 PolyIndex = 0; PolyIndex < Polys.Num(); PolyIndex++)
+	{
+		const FNavPoly& Poly = Polys[PolyIndex];
+		const TArray<FVector>& Verts = PolyVerts[PolyIndex];
+		bool bSampled = false;
+
+		if (Verts.Num() >= 3)
+		{
+			FBox PolyBounds(Verts);
+			FVector Normal = FVector::ZeroVector;
+			for (int32 VertIndex = 0; VertIndex < Verts.Num(); VertIndex++)
+				Normal += FVector::CrossProduct(Verts[VertIndex], Verts[(VertIndex + 1) % Verts.Num()]);
+
+			const int32 MinCellX = FMath::Max(FMath::FloorToInt((PolyBounds.Min.X - GridOrigin.X) / fBakedCellSize), 0);
+			const int32 MinCellY = FMath::Max(FMath::FloorToInt((PolyBounds.Min.Y - GridOrigin.Y) / fBakedCellSize), 0);
+			const int32 MaxCellX = FMath::Min(FMath::FloorToInt((PolyBounds.Max.X - GridOrigin.X) / fBakedCellSize), GridSizeX - 1);
+			const int32 MaxCellY = FMath::Min(FMath::FloorToInt((PolyBounds.Max.Y - GridOrigin.Y) / fBakedCellSize), GridSizeY - 1);
+
+			for (int32 CellY = MinCellY; CellY <= MaxCellY; CellY++)
+			{
+				for (int32 CellX = MinCellX; CellX <= MaxCellX; CellX++)
+				{
+					const FVector2D CellCenter(GridOrigin.X + (CellX + 0.5f) * fBakedCellSize, GridOrigin.Y + (CellY + 0.5f) * fBakedCellSize);
+					if (!IsInsidePolygon2D(Verts, CellCenter))
+						continue;
+
+					const float Height = FMath::Abs(Normal.Z) > KINDA_SMALL_NUMBER
+						? Poly.Center.Z - (Normal.X * (CellCenter.X - Poly.Center.X) + Normal.Y * (CellCenter.Y - Poly.Center.Y)) / Normal.Z
+						: Poly.Center.Z;
+
+					SampleLocations.Add(FVector(CellCenter.X, CellCenter.Y, Height + fSubjectHeight));
+					SampleCells.Add(CellY * GridSizeX + CellX);
+					bSampled = true;
+				}
+			}
+		}
+
+		// Polygons smaller than a cell may not contain any cell center.
+		if (!bSampled)
+		{
+			const int32 CellX = FMath::Clamp(FMath::FloorToInt((Poly.Center.X - GridOrigin.X) / fBakedCellSize), 0, GridSizeX - 1);
+			const int32 CellY = FMath::Clamp(FMath::FloorToInt((Poly.Center.Y - GridOrigin.Y) / fBakedCellSize), 0, GridSizeY - 1);
+			SampleLocations.Add(Poly.Center + FVector(0.f, 0.f, fSubjectHeight));
+			SampleCells.Add(CellY * GridSizeX + CellX);
+		}
+	}
+
+	// Score every camera over every sample in parallel.
+	const int32 NumCameras = Cameras.Num();
+	TArray<float> Scores;
+	Scores.SetNumZeroed(SampleLocations.Num() * NumCameras);
+
+	ParallelFor(SampleLocations.Num(), [&](int32 SampleIndex)
+	{
+		for (int32 CameraIndex = 0; CameraIndex < NumCameras; CameraIndex++)
+			Scores[SampleIndex * NumCameras + CameraIndex] = ScoreCamera(Cameras[CameraIndex], SampleLocations[SampleIndex]);
+	});
+
+	// Accumulate per cell (samples sorted by cell) and keep the best camera.
+	TArray<int32> SampleOrder;
+	SampleOrder.Reserve(SampleLocations.Num());
+	for (int32 SampleIndex = 0; SampleIndex < SampleLocations.Num(); SampleIndex++)
+		SampleOrder.Add(SampleIndex);
+	SampleOrder.Sort([&SampleCells](int32 A, int32 B) { return SampleCells[A] < SampleCells[B]; });
+
+	BakedCameras = Cameras;
+	CellCameras.Init(MAX_uint16, GridSizeX * GridSizeY);
+
+	int32 CoveredCells = 0;
+	TArray<float> CellScores;
+
+	for (int32 OrderIndex = 0; OrderIndex < SampleOrder.Num();)
+	{
+		const int32 CellIndex = SampleCells[SampleOrder[OrderIndex]];
+		CellScores.Init(0.f, NumCameras);
+
+		for (; OrderIndex < SampleOrder.Num() && SampleCells[SampleOrder[OrderIndex]] == CellIndex; OrderIndex++)
+		{
+			for (int32 CameraIndex = 0; CameraIndex < NumCameras; CameraIndex++)
+				CellScores[CameraIndex] += Scores[SampleOrder[OrderIndex] * NumCameras + CameraIndex];
+		}
+
+		float BestScore = 0.f;
+		for (int32 CameraIndex = 0; CameraIndex < NumCameras; CameraIndex++)
+		{
+			if (CellScores[CameraIndex] > BestScore)
+			{
+				BestScore = CellScores[CameraIndex];
+				CellCameras[CellIndex] = (uint16)CameraIndex;
+			}
+		}
+
+		if (BestScore > 0.f)
+			CoveredCells++;
+	}
+
+	UE_LOG(LogFixedCameraSystem, Log, TEXT("%s: baked %d samples against %d cameras into %dx%d cells (%d covered) in %.2f s."),
+		*GetName(), SampleLocations.Num(), NumCameras, GridSizeX, GridSizeY, CoveredCells, FPlatformTime::Seconds() - StartTime);
+}
+
+/// <summary>
+/// Returns true if a point is inside a convex polygon, ignoring heights.
+/// </summary>
+/// <param name="Verts">Polygon vertices in either winding order.</param>
+/// <param name="Point">Tested point.</param>
+bool AFixedCameraCoverageMap::IsInsidePolygon2D(const TArray<FVector>& Verts, const FVector2D& Point)
+{
+	bool bPositive = false;
+	bool bNegative = false;
+
+	for (int32 VertIndex = 0; VertIndex < Verts.Num(); VertIndex++)
+	{
+		const FVector& A = Verts[VertIndex];
+		const FVector& B = Verts[(VertIndex + 1) % Verts.Num()];
+		const float Cross = (B.X - A.X) * (Point.Y - A.Y) - (B.Y - A.Y) * (Point.X - A.X);
+
+		bPositive |= Cross > 0.f;
+		bNegative |= Cross < 0.f;
+		if (bPositive && bNegative)
+			return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Scores the view of a camera over a navmesh sample.
+/// </summary>
+/// <param name="Camera">Evaluated camera.</param>
+/// <param name="SampleLocation">Traced subject location.</param>
+float AFixedCameraCoverageMap::ScoreCamera(const AFixedCameraActor* Camera, const FVector& SampleLocation) const
+{
+	const FVector CameraLocation = Camera->Camera->GetComponentLocation();
+	const FVector ToSample = SampleLocation - CameraLocation;
+	const float Distance = ToSample.Size();
+
+	if (Distance <= KINDA_SMALL_NUMBER || Distance > fMaxDistance)
+		return 0.f;
+
+	const float HalfFOV = FMath::DegreesToRadians(Camera->Camera->FieldOfView * 0.5f);
+
+	// Cameras that do not follow the player keep their rotation, so the sample must be inside their view.
+	if (Camera->GetCameraFocus() == ECameraFocus::NoFocus || Camera->GetCameraFocus() == ECameraFocus::FocusOnObject)
+	{
+		if (FVector::DotProduct(ToSample / Distance, Camera->Camera->GetForwardVector()) < FMath::Cos(HalfFOV))
+			return 0.f;
+	}
+
+	// Visibility.
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FixedCameraCoverage), false, Camera);
+	if (GetWorld()->LineTraceTestByChannel(CameraLocation, SampleLocation, ECC_Visibility, QueryParams))
+		return 0.f;
+
+	// Distance and screen size.
+	const float DistanceScore = 1.f - Distance / fMaxDistance;
+	const float ScreenSize = fSubjectHeight / (Distance * FMath::Tan(HalfFOV));
+	const float ScreenSizeScore = FMath::Clamp(1.f - FMath::Abs(ScreenSize - fIdealScreenSize) / fIdealScreenSize, 0.f, 1.f);
+
+	return KINDA_SMALL_NUMBER + fDistanceWeight * DistanceScore + fScreenSizeWeight * ScreenSizeScore;
+}
+#endif
+#pragma endregion
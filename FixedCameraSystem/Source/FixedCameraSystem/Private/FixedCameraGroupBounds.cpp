@@ -0,0 +1,153 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraGroupBounds.h"
+
+#include "FixedCameraVectorMath.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+
+#pragma region CLASS_EVENTS
+/// <summary>
+/// Adds a member. Does nothing if it already belongs to the group.
+/// </summary>
+/// <param name="Actor">New member.</param>
+void FFixedCameraGroupBounds::Add(AActor* Actor)
+{
+	if (!Actor || MemberIndices.Contains(Actor))
+		return;
+
+	MemberIndices.Add(Actor, Members.Add(Actor));
+}
+
+/// <summary>
+/// Removes a member (swaps the last member into its slot).
+/// </summary>
+/// <param name="Actor">Member.</param>
+void FFixedCameraGroupBounds::Remove(AActor* Actor)
+{
+	int32 Index;
+	if (!MemberIndices.RemoveAndCopyValue(Actor, Index))
+		return;
+
+	Members.RemoveAtSwap(Index, 1, false);
+	if (Members.IsValidIndex(Index))
+		MemberIndices.Add(Members[Index], Index);
+}
+
+/// <summary>
+/// Removes every member.
+/// </summary>
+void FFixedCameraGroupBounds::Reset()
+{
+	Members.Reset();
+	MemberIndices.Reset();
+}
+
+/// <summary>
+/// Gathers the member bounds and returns the sphere containing all of them.
+/// </summary>
+/// <param name="OutCenter">Sphere center.</param>
+/// <param name="OutRadius">Sphere radius.</param>
+/// <returns>False if the group has no valid member.</returns>
+bool FFixedCameraGroupBounds::Compute(FVector& OutCenter, float& OutRadius)
+{
+	// Gather the bounds of the valid members into the packed arrays.
+	const int32 PaddedNum = Align(Members.Num(), 4);
+	CenterX.SetNumUninitialized(PaddedNum, false);
+	CenterY.SetNumUninitialized(PaddedNum, false);
+	CenterZ.SetNumUninitialized(PaddedNum, false);
+	Radius.SetNumUninitialized(PaddedNum, false);
+
+	int32 NumValid = 0;
+	for (const TWeakObjectPtr<AActor>& Member : Members)
+	{
+		const USceneComponent* Root = Member.IsValid() ? Member->GetRootComponent() : nullptr;
+		if (!Root)
+			continue;
+
+		CenterX[NumValid] = (float)Root->Bounds.Origin.X;
+		CenterY[NumValid] = (float)Root->Bounds.Origin.Y;
+		CenterZ[NumValid] = (float)Root->Bounds.Origin.Z;
+		Radius[NumValid] = (float)Root->Bounds.SphereRadius;
+		NumValid++;
+	}
+
+	if (NumValid == 0)
+		return false;
+
+	// Padding lanes repeat the first member, so they never change the result.
+	const int32 NumLanes = Align(NumValid, 4);
+	for (int32 Index = NumValid; Index < NumLanes; Index++)
+	{
+		CenterX[Index] = CenterX[0];
+		CenterY[Index] = CenterY[0];
+		CenterZ[Index] = CenterZ[0];
+		Radius[Index] = Radius[0];
+	}
+
+	// First pass: box containing every member sphere.
+	FFixedCameraVectorRegister MinX = VectorSetFloat1(MAX_flt);
+	FFixedCameraVectorRegister MinY = MinX;
+	FFixedCameraVectorRegister MinZ = MinX;
+	FFixedCameraVectorRegister MaxX = VectorSetFloat1(-MAX_flt);
+	FFixedCameraVectorRegister MaxY = MaxX;
+	FFixedCameraVectorRegister MaxZ = MaxX;
+
+	for (int32 Index = 0; Index < NumLanes; Index += 4)
+	{
+		const FFixedCameraVectorRegister R = VectorLoadAligned(&Radius[Index]);
+		const FFixedCameraVectorRegister X = VectorLoadAligned(&CenterX[Index]);
+		const FFixedCameraVectorRegister Y = VectorLoadAligned(&CenterY[Index]);
+		const FFixedCameraVectorRegister Z = VectorLoadAligned(&CenterZ[Index]);
+
+		MinX = VectorMin(MinX, VectorSubtract(X, R));
+		MinY = VectorMin(MinY, VectorSubtract(Y, R));
+		MinZ = VectorMin(MinZ, VectorSubtract(Z, R));
+		MaxX = VectorMax(MaxX, VectorAdd(X, R));
+		MaxY = VectorMax(MaxY, VectorAdd(Y, R));
+		MaxZ = VectorMax(MaxZ, VectorAdd(Z, R));
+	}
+
+	alignas(16) float Lanes[6][4];
+	VectorStoreAligned(MinX, Lanes[0]);
+	VectorStoreAligned(MinY, Lanes[1]);
+	VectorStoreAligned(MinZ, Lanes[2]);
+	VectorStoreAligned(MaxX, Lanes[3]);
+	VectorStoreAligned(MaxY, Lanes[4]);
+	VectorStoreAligned(MaxZ, Lanes[5]);
+
+	const FVector BoxMin(
+		FMath::Min(FMath::Min(Lanes[0][0], Lanes[0][1]), FMath::Min(Lanes[0][2], Lanes[0][3])),
+		FMath::Min(FMath::Min(Lanes[1][0], Lanes[1][1]), FMath::Min(Lanes[1][2], Lanes[1][3])),
+		FMath::Min(FMath::Min(Lanes[2][0], Lanes[2][1]), FMath::Min(Lanes[2][2], Lanes[2][3])));
+	const FVector BoxMax(
+		FMath::Max(FMath::Max(Lanes[3][0], Lanes[3][1]), FMath::Max(Lanes[3][2], Lanes[3][3])),
+		FMath::Max(FMath::Max(Lanes[4][0], Lanes[4][1]), FMath::Max(Lanes[4][2], Lanes[4][3])),
+		FMath::Max(FMath::Max(Lanes[5][0], Lanes[5][1]), FMath::Max(Lanes[5][2], Lanes[5][3])));
+
+	OutCenter = (BoxMin + BoxMax) * 0.5f;
+
+	// Second pass: farthest member sphere from the box center.
+	const FFixedCameraVectorRegister CX = VectorSetFloat1((float)OutCenter.X);
+	const FFixedCameraVectorRegister CY = VectorSetFloat1((float)OutCenter.Y);
+	const FFixedCameraVectorRegister CZ = VectorSetFloat1((float)OutCenter.Z);
+	const FFixedCameraVectorRegister Epsilon = VectorSetFloat1(KINDA_SMALL_NUMBER);
+	FFixedCameraVectorRegister MaxDistance = VectorZero();
+
+	for (int32 Index = 0; Index < NumLanes; Index += 4)
+	{
+		const FFixedCameraVectorRegister DX = VectorSubtract(VectorLoadAligned(&CenterX[Index]), CX);
+		const FFixedCameraVectorRegister DY = VectorSubtract(VectorLoadAligned(&CenterY[Index]), CY);
+		const FFixedCameraVectorRegister DZ = VectorSubtract(VectorLoadAligned(&CenterZ[Index]), CZ);
+		const FFixedCameraVectorRegister DistanceSquared = VectorAdd(VectorMultiplyAdd(DX, DX, VectorMultiply(DY, DY)), VectorMultiplyAdd(DZ, DZ, Epsilon));
+		const FFixedCameraVectorRegister Distance = VectorMultiply(DistanceSquared, VectorReciprocalSqrt(DistanceSquared));
+
+		MaxDistance = VectorMax(MaxDistance, VectorAdd(Distance, VectorLoadAligned(&Radius[Index])));
+	}
+
+	VectorStoreAligned(MaxDistance, Lanes[0]);
+	OutRadius = FMath::Max(FMath::Max(Lanes[0][0], Lanes[0][1]), FMath::Max(Lanes[0][2], Lanes[0][3]));
+
+	return true;
+}
+#pragma endregion
@@ -0,0 +1,194 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraOccluderFader.h"
+
+#include "FixedCameraActor.h"
+#include "Engine/World.h"
+#include "Components/MeshComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+#pragma region CLASS_EVENTS
+/// <summary>
+/// Consumes last frame sweep, updates the fades and issues the next sweep.
+/// </summary>
+/// <param name="DeltaTime">Time between frames.</param>
+/// <param name="Camera">Active camera.</param>
+/// <param name="Target">Actor that must stay visible.</param>
+void UFixedCameraOccluderFader::Tick(float DeltaTime, const AFixedCameraActor* Camera, AActor* Target)
+{
+	UWorld* World = GetWorld();
+	const bool bFading = Camera && Camera->bFadeOccluders && Target;
+
+	if (bFading)
+	{
+		fFadedOpacity = Camera->fOccluderFadedOpacity;
+		fFadeSpeed = Camera->fOccluderFadeSpeed;
+		OpacityParameter = Camera->OccluderOpacityParameter;
+	}
+
+	// Consume last frame sweep.
+	FTraceDatum TraceDatum;
+	const bool bHasResult = SweepHandle.IsValid() && World->QueryTraceData(SweepHandle, TraceDatum);
+	SweepHandle = FTraceHandle();
+
+	if (bHasResult || !bFading)
+	{
+		for (TPair<TWeakObjectPtr<UMeshComponent>, FFixedCameraFadedMesh>& FadedMesh : FadedMeshes)
+			FadedMesh.Value.bOccluding = false;
+	}
+
+	if (bHasResult && bFading)
+	{
+		for (const FHitResult& Hit : TraceDatum.OutHits)
+		{
+			UMeshComponent* Mesh = Cast<UMeshComponent>(Hit.GetComponent());
+			if (!Mesh || Mesh->GetOwner() == Target)
+				continue;
+
+			FFixedCameraFadedMesh* FadedMesh = FadedMeshes.Find(Mesh);
+			if (!FadedMesh)
+			{
+				FadedMesh = &FadedMeshes.Add(Mesh);
+				BeginFade(Mesh, *FadedMesh);
+			}
+			FadedMesh->bOccluding = true;
+		}
+	}
+
+	// Update the fades, restoring the meshes that are fully visible again.
+	for (auto It = FadedMeshes.CreateIterator(); It; ++It)
+	{
+		UMeshComponent* Mesh = It->Key.Get();
+		FFixedCameraFadedMesh& FadedMesh = It->Value;
+
+		if (!Mesh)
+		{
+			EndFade(nullptr, FadedMesh);
+			It.RemoveCurrent();
+			continue;
+		}
+
+		const float fTargetOpacity = FadedMesh.bOccluding ? fFadedOpacity : 1.f;
+		FadedMesh.fOpacity = FMath::FInterpConstantTo(FadedMesh.fOpacity, fTargetOpacity, DeltaTime, fFadeSpeed);
+
+		if (!FadedMesh.bOccluding && FadedMesh.fOpacity >= 1.f)
+		{
+			EndFade(Mesh, FadedMesh);
+			It.RemoveCurrent();
+			continue;
+		}
+
+		for (UMaterialInstanceDynamic* Instance : FadedMesh.Instances)
+		{
+			if (Instance)
+				Instance->SetScalarParameterValue(OpacityParameter, FadedMesh.fOpacity);
+		}
+	}
+
+	if (!bFading)
+		return;
+
+	// Issue this frame sweep. Object type queries report every hit, so stacked occluders are found at once.
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FixedCameraOccluderFade), false);
+	QueryParams.AddIgnoredActor(Camera);
+	QueryParams.AddIgnoredActor(Target);
+
+	FCollisionObjectQueryParams ObjectQueryParams;
+	ObjectQueryParams.AddObjectTypesToQuery(ECC_WorldStatic);
+	ObjectQueryParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+
+	SweepHandle = World->AsyncSweepByObjectType(EAsyncTraceType::Multi, Camera->Camera->GetComponentLocation(), Target->GetActorLocation(), FQuat::Identity, ObjectQueryParams, FCollisionShape::MakeSphere(Camera->fOccluderSweepRadius), QueryParams);
+}
+
+/// <summary>
+/// Restores every faded mesh immediately.
+/// </summary>
+void UFixedCameraOccluderFader::RestoreAll()
+{
+	for (TPair<TWeakObjectPtr<UMeshComponent>, FFixedCameraFadedMesh>& FadedMesh : FadedMeshes)
+		EndFade(FadedMesh.Key.Get(), FadedMesh.Value);
+
+	FadedMeshes.Reset();
+	SweepHandle = FTraceHandle();
+}
+
+/// <summary>
+/// Replaces the materials of a mesh with pooled instances.
+/// </summary>
+/// <param name="Mesh">Occluding mesh.</param>
+/// <param name="OutFadedMesh">Faded mesh state.</param>
+void UFixedCameraOccluderFader::BeginFade(UMeshComponent* Mesh, FFixedCameraFadedMesh& OutFadedMesh)
+{
+	const int32 NumMaterials = Mesh->GetNumMaterials();
+	OutFadedMesh.OriginalMaterials.SetNumZeroed(NumMaterials);
+	OutFadedMesh.Instances.SetNumZeroed(NumMaterials);
+
+	for (int32 ElementIndex = 0; ElementIndex < NumMaterials; ElementIndex++)
+	{
+		UMaterialInterface* Material = Mesh->GetMaterial(ElementIndex);
+		if (!Material)
+			continue;
+
+		UMaterialInstanceDynamic* Instance = AcquireInstance(Material);
+		OutFadedMesh.OriginalMaterials[ElementIndex] = Material;
+		OutFadedMesh.Instances[ElementIndex] = Instance;
+		Mesh->SetMaterial(ElementIndex, Instance);
+	}
+}
+
+/// <summary>
+/// Restores the original materials of a mesh and returns its instances to the pool.
+/// </summary>
+/// <param name="Mesh">Faded mesh (may be pending kill).</param>
+/// <param name="FadedMesh">Faded mesh state.</param>
+void UFixedCameraOccluderFader::EndFade(UMeshComponent* Mesh, FFixedCameraFadedMesh& FadedMesh)
+{
+	for (int32 ElementIndex = 0; ElementIndex < FadedMesh.Instances.Num(); ElementIndex++)
+	{
+		UMaterialInstanceDynamic* Instance = FadedMesh.Instances[ElementIndex];
+		if (!Instance)
+			continue;
+
+		// Only restore the slot if nothing else replaced the material meanwhile.
+		if (Mesh && Mesh->GetMaterial(ElementIndex) == Instance)
+			Mesh->SetMaterial(ElementIndex, FadedMesh.OriginalMaterials[ElementIndex]);
+
+		ReleaseInstance(Instance);
+	}
+
+	FadedMesh.OriginalMaterials.Reset();
+	FadedMesh.Instances.Reset();
+}
+
+/// <summary>
+/// Returns a pooled instance of the parent material, creating one if the pool is empty.
+/// </summary>
+/// <param name="Parent">Parent material.</param>
+UMaterialInstanceDynamic* UFixedCameraOccluderFader::AcquireInstance(UMaterialInterface* Parent)
+{
+	FFixedCameraMaterialInstancePool& Pool = InstancePools.FindOrAdd(Parent);
+
+	while (Pool.FreeInstances.Num() > 0)
+	{
+		UMaterialInstanceDynamic* Instance = Pool.FreeInstances.Pop(false);
+		if (IsValid(Instance))
+			return Instance;
+	}
+
+	// Instances are owned by the fader so they survive the meshes they are applied to.
+	return UMaterialInstanceDynamic::Create(Parent, this);
+}
+
+/// <summary>
+/// Returns an instance to its pool.
+/// </summary>
+/// <param name="Instance">Dynamic material instance.</param>
+void UFixedCameraOccluderFader::ReleaseInstance(UMaterialInstanceDynamic* Instance)
+{
+	if (!IsValid(Instance))
+		return;
+
+	Instance->ClearParameterValues();
+	InstancePools.FindOrAdd(Instance->Parent).FreeInstances.Add(Instance);
+}
+#pragma endregion
@@ -62,6 +62,15 @@ FVector AFixedCameraPath::GetLocationAlongRail(float TravellingDistance)
 	return CameraPath->GetLocationAtDistanceAlongSpline(TravellingDistance, ESplineCoordinateSpace::World);
 }
 
+/// <summary>
+/// Returns the distance along the rail of the closest rail point to a location.
+/// </summary>
+/// <param name="Location">World location.</param>
+float AFixedCameraPath::GetDistanceAlongRail(const FVector& Location) const
+{
+	return CameraPath->GetDistanceAlongSplineAtSplineInputKey(CameraPath->FindInputKeyClosestToWorldLocation(Location));
+}
+
 /// <summary>
 /// Returns first spline point location.
 /// </summary>
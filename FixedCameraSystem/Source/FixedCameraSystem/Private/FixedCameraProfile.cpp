@@ -0,0 +1,88 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraProfile.h"
+
+#pragma region CLASS_EVENTS
+/// <summary>
+/// Nothing is overridden by default.
+/// </summary>
+FFixedCameraProfileOverrides::FFixedCameraProfileOverrides()
+	: bOverride_fRailTravellingDistance(false)
+	, bOverride_bSmoothMovement(false)
+	, bOverride_fSmoothMovementSpeed(false)
+	, bOverride_CameraFocus(false)
+	, bOverride_fMiddlePointAlpha(false)
+	, bOverride_bSmoothRotation(false)
+	, bOverride_fSmoothRotationSpeed(false)
+	, bOverride_bIncludePlayerInGroup(false)
+	, bOverride_bFitGroupInView(false)
+	, bOverride_fGroupFramingPadding(false)
+	, bOverride_fMinGroupFieldOfView(false)
+	, bOverride_bUseDeadZone(false)
+	, bOverride_DeadZone(false)
+	, bOverride_SoftZone(false)
+	, bOverride_fFieldOfView(false)
+{
+}
+
+/// <summary>
+/// Writes the overridden values into the resolved settings.
+/// </summary>
+/// <param name="Settings">Settings to fill.</param>
+void FFixedCameraProfileOverrides::ApplyTo(FFixedCameraSettings& Settings) const
+{
+	if (bOverride_fRailTravellingDistance)
+		Settings.fRailTravellingDistance = fRailTravellingDistance;
+	if (bOverride_bSmoothMovement)
+		Settings.bSmoothMovement = bSmoothMovement;
+	if (bOverride_fSmoothMovementSpeed)
+		Settings.fSmoothMovementSpeed = fSmoothMovementSpeed;
+	if (bOverride_CameraFocus)
+		Settings.CameraFocus = CameraFocus;
+	if (bOverride_fMiddlePointAlpha)
+		Settings.fMiddlePointAlpha = fMiddlePointAlpha;
+	if (bOverride_bSmoothRotation)
+		Settings.bSmoothRotation = bSmoothRotation;
+	if (bOverride_fSmoothRotationSpeed)
+		Settings.fSmoothRotationSpeed = fSmoothRotationSpeed;
+	if (bOverride_bIncludePlayerInGroup)
+		Settings.bIncludePlayerInGroup = bIncludePlayerInGroup;
+	if (bOverride_bFitGroupInView)
+		Settings.bFitGroupInView = bFitGroupInView;
+	if (bOverride_fGroupFramingPadding)
+		Settings.fGroupFramingPadding = fGroupFramingPadding;
+	if (bOverride_fMinGroupFieldOfView)
+		Settings.fMinGroupFieldOfView = fMinGroupFieldOfView;
+	if (bOverride_bUseDeadZone)
+		Settings.bUseDeadZone = bUseDeadZone;
+	if (bOverride_DeadZone)
+		Settings.DeadZone = DeadZone;
+	if (bOverride_SoftZone)
+		Settings.SoftZone = SoftZone;
+	if (bOverride_fFieldOfView)
+		Settings.fFieldOfView = fFieldOfView;
+}
+
+/// <summary>
+/// Writes the profile values into the resolved settings.
+/// </summary>
+/// <param name="Settings">Settings to fill.</param>
+void UFixedCameraProfile::GetSettings(FFixedCameraSettings& Settings) const
+{
+	Settings.fRailTravellingDistance = fRailTravellingDistance;
+	Settings.bSmoothMovement = bSmoothMovement;
+	Settings.fSmoothMovementSpeed = fSmoothMovementSpeed;
+	Settings.CameraFocus = CameraFocus;
+	Settings.fMiddlePointAlpha = fMiddlePointAlpha;
+	Settings.bSmoothRotation = bSmoothRotation;
+	Settings.fSmoothRotationSpeed = fSmoothRotationSpeed;
+	Settings.bIncludePlayerInGroup = bIncludePlayerInGroup;
+	Settings.bFitGroupInView = bFitGroupInView;
+	Settings.fGroupFramingPadding = fGroupFramingPadding;
+	Settings.fMinGroupFieldOfView = fMinGroupFieldOfView;
+	Settings.bUseDeadZone = bUseDeadZone;
+	Settings.DeadZone = DeadZone;
+	Settings.SoftZone = SoftZone;
+	Settings.fFieldOfView = fFieldOfView;
+}
+#pragma endregion
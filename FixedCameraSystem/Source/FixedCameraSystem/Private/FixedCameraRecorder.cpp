@@ -0,0 +1,423 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraRecorder.h"
+
+namespace FixedCameraRecorder
+{
+	/// <summary>
+	/// Frame header bits: one per changed value (location XYZ, rotation PYR, field of view) and the camera switch.
+	/// </summary>
+	static const uint8 FieldOfViewBit = 1 << 6;
+	static const uint8 SwitchBit = 1 << 7;
+	static const int32 NumValues = 7;
+
+	static void WriteVarint(TArray<uint8>& Bytes, uint64 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Bytes.Add((uint8)(Value | 0x80));
+			Value >>= 7;
+		}
+		Bytes.Add((uint8)Value);
+	}
+
+	static uint64 ReadVarint(const TArray<uint8>& Bytes, int32& Offset)
+	{
+		uint64 Value = 0;
+		for (int32 Shift = 0; Offset < Bytes.Num() && Shift < 64; Shift += 7)
+		{
+			const uint8 Byte = Bytes[Offset++];
+			Value |= (uint64)(Byte & 0x7F) << Shift;
+			if (!(Byte & 0x80))
+				break;
+		}
+		return Value;
+	}
+
+	/// <summary>
+	/// Maps signed deltas to unsigned ones, so small negative deltas also take a single byte.
+	/// </summary>
+	static uint64 ZigZag(int64 Value)
+	{
+		return ((uint64)Value << 1) ^ (uint64)(Value >> 63);
+	}
+
+	static int64 UnZigZag(uint64 Value)
+	{
+		return (int64)(Value >> 1) ^ -(int64)(Value & 1);
+	}
+
+	static FVector GetLocation(const FFixedCameraRecordedFrame& Frame)
+	{
+		return FVector(Frame.Location[0], Frame.Location[1], Frame.Location[2]) * 0.1f;
+	}
+
+	static FRotator GetRotation(const FFixedCameraRecordedFrame& Frame)
+	{
+		return FRotator(FRotator::DecompressAxisFromShort(Frame.Rotation[0]), FRotator::DecompressAxisFromShort(Frame.Rotation[1]), FRotator::DecompressAxisFromShort(Frame.Rotation[2]));
+	}
+
+	static float GetFieldOfView(const FFixedCameraRecordedFrame& Frame)
+	{
+		return Frame.FieldOfView * 0.01f;
+	}
+}
+
+#pragma region CLASS_EVENTS
+/// <summary>
+/// Clears the recording and starts a new one.
+/// </summary>
+/// <param name="fMaxDuration">Seconds kept, older chunks are overwritten.</param>
+/// <param name="fSampleRate">Recorded frames per second (camera switches are always recorded).</param>
+/// <param name="fInKeyframeInterval">Seconds between keyframes.</param>
+void FFixedCameraRecorder::Start(float fMaxDuration, float fSampleRate, float fInKeyframeInterval)
+{
+	Reset();
+
+	fSampleInterval = fSampleRate > 0.f ? 1.f / fSampleRate : 0.f;
+	fKeyframeInterval = FMath::Max(fInKeyframeInterval, 0.05f);
+
+	// One more chunk than the duration needs, the oldest one is partially overwritten.
+	Chunks.SetNum(FMath::Max(FMath::CeilToInt(fMaxDuration / fKeyframeInterval), 1) + 1);
+	bRecording = true;
+}
+
+/// <summary>
+/// Stops recording, keeping the recorded frames.
+/// </summary>
+void FFixedCameraRecorder::Stop()
+{
+	bRecording = false;
+}
+
+/// <summary>
+/// Removes every recorded frame.
+/// </summary>
+void FFixedCameraRecorder::Reset()
+{
+	Chunks.Empty();
+	FirstChunk = 0;
+	NumChunks = 0;
+	CameraIds.Reset();
+	CameraIndices.Reset();
+	LastFrame = FFixedCameraRecordedFrame();
+	fLastTime = 0.f;
+	bRecording = false;
+}
+
+/// <summary>
+/// Records a camera view.
+/// </summary>
+/// <param name="fTime">World time.</param>
+/// <param name="Location">View location.</param>
+/// <param name="Rotation">View rotation.</param>
+/// <param name="fFieldOfView">View field of view.</param>
+/// <param name="CameraId">Active fixed camera identifier.</param>
+void FFixedCameraRecorder::Record(float fTime, const FVector& Location, const FRotator& Rotation, float fFieldOfView, FName CameraId)
+{
+	if (!bRecording || Chunks.Num() == 0)
+		return;
+
+	int32 CameraIndex;
+	if (const int32* ExistingIndex = CameraIndices.Find(CameraId))
+	{
+		CameraIndex = *ExistingIndex;
+	}
+	else
+	{
+		CameraIndex = CameraIds.Add(CameraId);
+		CameraIndices.Add(CameraId, CameraIndex);
+	}
+
+	const bool bHasFrame = NumChunks > 0;
+	const bool bSwitch = bHasFrame && CameraIndex != LastFrame.CameraIndex;
+	if (bHasFrame && !bSwitch && fTime - fLastTime < fSampleInterval)
+		return;
+
+	FFixedCameraRecordedChunk* Chunk = bHasFrame ? &Chunks[(FirstChunk + NumChunks - 1) % Chunks.Num()] : nullptr;
+	if (!Chunk || fTime - Chunk->fStartTime >= fKeyframeInterval)
+	{
+		// The oldest chunk is reused once the ring is full.
+		int32 Slot;
+		if (NumChunks < Chunks.Num())
+		{
+			Slot = (FirstChunk + NumChunks) % Chunks.Num();
+			NumChunks++;
+		}
+		else
+		{
+			Slot = FirstChunk;
+			FirstChunk = (FirstChunk + 1) % Chunks.Num();
+		}
+
+		Chunk = &Chunks[Slot];
+		Chunk->Bytes.Reset();
+		Chunk->fStartTime = fTime;
+	}
+
+	FFixedCameraRecordedFrame Frame;
+	Frame.TimeMs = Chunk->Bytes.Num() > 0 ? FMath::Max(FMath::RoundToInt((fTime - Chunk->fStartTime) * 1000.f), LastFrame.TimeMs) : 0;
+	Frame.Location[0] = FMath::RoundToInt(Location.X * 10.f);
+	Frame.Location[1] = FMath::RoundToInt(Location.Y * 10.f);
+	Frame.Location[2] = FMath::RoundToInt(Location.Z * 10.f);
+	Frame.Rotation[0] = FRotator::CompressAxisToShort(Rotation.Pitch);
+	Frame.Rotation[1] = FRotator::CompressAxisToShort(Rotation.Yaw);
+	Frame.Rotation[2] = FRotator::CompressAxisToShort(Rotation.Roll);
+	Frame.FieldOfView = (uint16)FMath::Clamp(FMath::RoundToInt(fFieldOfView * 100.f), 0, 65535);
+	Frame.CameraIndex = CameraIndex;
+
+	WriteFrame(*Chunk, Frame, bSwitch);
+
+	Chunk->fEndTime = fTime;
+	LastFrame = Frame;
+	fLastTime = fTime;
+}
+
+/// <summary>
+/// Returns the time of the first and last recorded frames.
+/// </summary>
+/// <returns>False if nothing is recorded.</returns>
+bool FFixedCameraRecorder::GetTimeRange(float& OutStartTime, float& OutEndTime) const
+{
+	if (NumChunks == 0)
+		return false;
+
+	OutStartTime = GetChunk(0).fStartTime;
+	OutEndTime = GetChunk(NumChunks - 1).fEndTime;
+	return true;
+}
+
+/// <summary>
+/// Returns the recorded view at a time. Views are interpolated between frames, except across camera switches.
+/// </summary>
+/// <param name="fTime">World time (clamped to the recorded range).</param>
+/// <returns>False if nothing is recorded.</returns>
+bool FFixedCameraRecorder::Sample(float fTime, FVector& OutLocation, FRotator& OutRotation, float& OutFieldOfView, FName& OutCameraId) const
+{
+	if (NumChunks == 0)
+		return false;
+
+	const int32 ChunkIndex = FindChunk(fTime);
+	const FFixedCameraRecordedChunk& Chunk = GetChunk(ChunkIndex);
+
+	FFixedCameraRecordedFrame Before;
+	FFixedCameraRecordedFrame After;
+	float fBeforeTime = 0.f;
+	float fAfterTime = 0.f;
+	bool bHasBefore = false;
+	bool bHasAfter = false;
+	bool bAfterSwitch = false;
+
+	DecodeChunk(Chunk, [&](const FFixedCameraRecordedFrame& Frame, bool bSwitch)
+	{
+		const float fFrameTime = GetFrameTime(Chunk, Frame);
+		if (!bHasBefore || fFrameTime <= fTime)
+		{
+			Before = Frame;
+			fBeforeTime = fFrameTime;
+			bHasBefore = true;
+			return true;
+		}
+
+		After = Frame;
+		fAfterTime = fFrameTime;
+		bAfterSwitch = bSwitch;
+		bHasAfter = true;
+		return false;
+	});
+
+	// The next frame may be the keyframe of the next chunk.
+	if (!bHasAfter && ChunkIndex + 1 < NumChunks)
+	{
+		const FFixedCameraRecordedChunk& NextChunk = GetChunk(ChunkIndex + 1);
+		DecodeChunk(NextChunk, [&](const FFixedCameraRecordedFrame& Frame, bool bSwitch)
+		{
+			After = Frame;
+			fAfterTime = GetFrameTime(NextChunk, Frame);
+			bAfterSwitch = bSwitch;
+			bHasAfter = true;
+			return false;
+		});
+	}
+
+	if (!bHasBefore)
+		return false;
+
+	// Camera cuts are kept as cuts.
+	if (bHasAfter && !bAfterSwitch && fAfterTime > fBeforeTime)
+	{
+		const float fAlpha = FMath::Clamp((fTime - fBeforeTime) / (fAfterTime - fBeforeTime), 0.f, 1.f);
+		OutLocation = FMath::Lerp(FixedCameraRecorder::GetLocation(Before), FixedCameraRecorder::GetLocation(After), fAlpha);
+		// Decoded axes are in [0, 360), so the rotation is interpolated along the shortest arc.
+		OutRotation = FQuat::Slerp(FQuat(FixedCameraRecorder::GetRotation(Before)), FQuat(FixedCameraRecorder::GetRotation(After)), fAlpha).Rotator();
+		OutFieldOfView = FMath::Lerp(FixedCameraRecorder::GetFieldOfView(Before), FixedCameraRecorder::GetFieldOfView(After), fAlpha);
+	}
+	else
+	{
+		OutLocation = FixedCameraRecorder::GetLocation(Before);
+		OutRotation = FixedCameraRecorder::GetRotation(Before);
+		OutFieldOfView = FixedCameraRecorder::GetFieldOfView(Before);
+	}
+
+	OutCameraId = CameraIds.IsValidIndex(Before.CameraIndex) ? CameraIds[Before.CameraIndex] : NAME_None;
+	return true;
+}
+
+/// <summary>
+/// Returns the camera switches recorded in a time range.
+/// </summary>
+/// <param name="fStartTime">Range start.</param>
+/// <param name="fEndTime">Range end.</param>
+/// <param name="OutSwitches">Camera switches, in time order.</param>
+void FFixedCameraRecorder::GetSwitches(float fStartTime, float fEndTime, TArray<FFixedCameraRecordedSwitch>& OutSwitches) const
+{
+	OutSwitches.Reset();
+	if (NumChunks == 0)
+		return;
+
+	int32 PreviousCameraIndex = INDEX_NONE;
+	for (int32 ChunkIndex = FindChunk(fStartTime); ChunkIndex < NumChunks; ChunkIndex++)
+	{
+		const FFixedCameraRecordedChunk& Chunk = GetChunk(ChunkIndex);
+		if (Chunk.fStartTime > fEndTime)
+			break;
+
+		DecodeChunk(Chunk, [&](const FFixedCameraRecordedFrame& Frame, bool bSwitch)
+		{
+			const float fFrameTime = GetFrameTime(Chunk, Frame);
+			if (fFrameTime > fEndTime)
+				return false;
+
+			if (bSwitch && fFrameTime >= fStartTime)
+			{
+				FFixedCameraRecordedSwitch& Switch = OutSwitches.AddDefaulted_GetRef();
+				Switch.fTime = fFrameTime;
+				Switch.PreviousCameraId = CameraIds.IsValidIndex(PreviousCameraIndex) ? CameraIds[PreviousCameraIndex] : NAME_None;
+				Switch.NextCameraId = CameraIds.IsValidIndex(Frame.CameraIndex) ? CameraIds[Frame.CameraIndex] : NAME_None;
+			}
+
+			PreviousCameraIndex = Frame.CameraIndex;
+			return true;
+		});
+	}
+}
+
+/// <summary>
+/// Returns the bytes used by the recorded frames.
+/// </summary>
+int32 FFixedCameraRecorder::GetRecordedSize() const
+{
+	int32 Size = 0;
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ChunkIndex++)
+		Size += GetChunk(ChunkIndex).Bytes.Num();
+
+	return Size;
+}
+
+/// <summary>
+/// Returns the position of the last chunk starting at or before a time (0 if the time is before every chunk).
+/// </summary>
+int32 FFixedCameraRecorder::FindChunk(float fTime) const
+{
+	int32 Low = 0;
+	int32 High = NumChunks - 1;
+	while (Low < High)
+	{
+		const int32 Middle = (Low + High + 1) / 2;
+		if (GetChunk(Middle).fStartTime <= fTime)
+			Low = Middle;
+		else
+			High = Middle - 1;
+	}
+
+	return Low;
+}
+
+/// <summary>
+/// Appends a frame to a chunk, as a keyframe if it is the first one.
+/// </summary>
+/// <param name="Chunk">Chunk.</param>
+/// <param name="Frame">Quantized frame.</param>
+/// <param name="bSwitch">The camera changed since the last frame.</param>
+void FFixedCameraRecorder::WriteFrame(FFixedCameraRecordedChunk& Chunk, const FFixedCameraRecordedFrame& Frame, bool bSwitch)
+{
+	// Keyframes are deltas from zero with every value written.
+	const bool bKeyframe = Chunk.Bytes.Num() == 0;
+	const FFixedCameraRecordedFrame Base = bKeyframe ? FFixedCameraRecordedFrame() : LastFrame;
+
+	int64 Deltas[FixedCameraRecorder::NumValues];
+	for (int32 Axis = 0; Axis < 3; Axis++)
+	{
+		Deltas[Axis] = (int64)Frame.Location[Axis] - Base.Location[Axis];
+
+		// Rotation deltas wrap around, so they always take the short way.
+		Deltas[3 + Axis] = (int16)(uint16)(Frame.Rotation[Axis] - Base.Rotation[Axis]);
+	}
+	Deltas[6] = (int64)Frame.FieldOfView - Base.FieldOfView;
+
+	uint8 Header = bSwitch ? FixedCameraRecorder::SwitchBit : 0;
+	for (int32 Value = 0; Value < FixedCameraRecorder::NumValues; Value++)
+	{
+		if (bKeyframe || Deltas[Value] != 0)
+			Header |= 1 << Value;
+	}
+
+	Chunk.Bytes.Add(Header);
+
+	if (!bKeyframe)
+		FixedCameraRecorder::WriteVarint(Chunk.Bytes, (uint64)(Frame.TimeMs - Base.TimeMs));
+
+	for (int32 Value = 0; Value < FixedCameraRecorder::NumValues; Value++)
+	{
+		if (Header & (1 << Value))
+			FixedCameraRecorder::WriteVarint(Chunk.Bytes, FixedCameraRecorder::ZigZag(Deltas[Value]));
+	}
+
+	if (bKeyframe || bSwitch)
+		FixedCameraRecorder::WriteVarint(Chunk.Bytes, (uint64)Frame.CameraIndex);
+}
+
+/// <summary>
+/// Decodes the frames of a chunk in order until the visitor returns false.
+/// </summary>
+/// <param name="Chunk">Chunk.</param>
+/// <param name="Visitor">Called with each frame and whether the camera switched on it.</param>
+void FFixedCameraRecorder::DecodeChunk(const FFixedCameraRecordedChunk& Chunk, TFunctionRef<bool(const FFixedCameraRecordedFrame&, bool)> Visitor)
+{
+	FFixedCameraRecordedFrame Frame;
+	int32 Offset = 0;
+	bool bKeyframe = true;
+
+	while (Offset < Chunk.Bytes.Num())
+	{
+		const uint8 Header = Chunk.Bytes[Offset++];
+
+		if (!bKeyframe)
+			Frame.TimeMs += (int32)FixedCameraRecorder::ReadVarint(Chunk.Bytes, Offset);
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			if (Header & (1 << Axis))
+				Frame.Location[Axis] = (int32)(Frame.Location[Axis] + FixedCameraRecorder::UnZigZag(FixedCameraRecorder::ReadVarint(Chunk.Bytes, Offset)));
+		}
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			if (Header & (1 << (3 + Axis)))
+				Frame.Rotation[Axis] = (uint16)(Frame.Rotation[Axis] + FixedCameraRecorder::UnZigZag(FixedCameraRecorder::ReadVarint(Chunk.Bytes, Offset)));
+		}
+
+		if (Header & FixedCameraRecorder::FieldOfViewBit)
+			Frame.FieldOfView = (uint16)(Frame.FieldOfView + FixedCameraRecorder::UnZigZag(FixedCameraRecorder::ReadVarint(Chunk.Bytes, Offset)));
+
+		const bool bSwitch = (Header & FixedCameraRecorder::SwitchBit) != 0;
+		if (bKeyframe || bSwitch)
+			Frame.CameraIndex = (int32)FixedCameraRecorder::ReadVarint(Chunk.Bytes, Offset);
+
+		bKeyframe = false;
+
+		if (!Visitor(Frame, bSwitch))
+			return;
+	}
+}
+#pragma endregion
@@ -0,0 +1,1245 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraSubsystem.h"
+
+#include "FixedCameraSystem.h"
+#include "FixedCameraActor.h"
+#include "FixedCameraZoneGraph.h"
+#include "FixedCameraTrigger.h"
+#include "FixedCameraSignificanceComponent.h"
+#include "FixedCameraOccluderFader.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "SceneManagement.h"
+#include "ContentStreaming.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LevelStreaming.h"
+#include "EngineUtils.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
+#include "Math/Float16.h"
+
+#pragma region UNREAL_ENGINE_EVENTS
+/// <summary>
+/// Restores the faded occluders.
+/// </summary>
+void UFixedCameraSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(RecordingTickHandle);
+	RecordingTickHandle.Reset();
+
+	if (OccluderFader)
+		OccluderFader->RestoreAll();
+
+	Super::Deinitialize();
+}
+
+#if ENGINE_MAJOR_VERSION >= 5
+/// <summary>
+/// Registers every camera and zone graph of the world at once, before their BeginPlay.
+/// </summary>
+/// <param name="InWorld">World.</param>
+void UFixedCameraSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (TActorIterator<AFixedCameraActor> It(&InWorld); It; ++It)
+		RegisterCamera(*It);
+
+	for (TActorIterator<AFixedCameraZoneGraph> It(&InWorld); It; ++It)
+		RegisterZoneGraph(*It);
+}
+#endif
+
+/// <summary>
+/// Called every frame.
+/// </summary>
+/// <param name="DeltaTime">Time between frames.</param>
+void UFixedCameraSubsystem::Tick(float DeltaTime)
+{
+	if (bUpcomingCamerasDirty)
+	{
+		UpdateUpcomingCameras();
+		ApplyCameraStreaming();
+		bSignificanceViewsDirty = true;
+	}
+
+	// Significance is updated this frame instead of waiting for the next interval.
+	if (bSignificanceViewsDirty)
+	{
+		bSignificanceViewsDirty = false;
+		CacheSignificanceViews();
+		fSignificanceTimer = SignificanceUpdateInterval;
+	}
+
+	if (bVisibilitySetsDirty)
+	{
+		bVisibilitySetsDirty = false;
+		if (ActiveCamera)
+			ApplyVisibilitySets(BlendingOutCamera ? TArray<AFixedCameraActor*>({ BlendingOutCamera, ActiveCamera }) : TArray<AFixedCameraActor*>({ ActiveCamera }));
+	}
+
+	// Switches found by the async physics tick of the triggers.
+	for (AFixedCameraTrigger* Trigger : Triggers)
+	{
+		if (Trigger)
+			Trigger->ApplyPendingSwitches();
+	}
+
+	AddUpcomingStreamingViews();
+	UpdateOcclusion();
+
+	// Keeps ticking after a switch until the previous occluders have faded back in.
+	const bool bFadeOccluders = ActiveCamera && ActiveCamera->bFadeOccluders;
+	if (bFadeOccluders && !OccluderFader)
+		OccluderFader = NewObject<UFixedCameraOccluderFader>(this);
+
+	if (OccluderFader && (bFadeOccluders || !OccluderFader->IsIdle()))
+		OccluderFader->Tick(DeltaTime, ActiveCamera, UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+
+	fSignificanceTimer += DeltaTime;
+	if (fSignificanceTimer >= SignificanceUpdateInterval)
+	{
+		fSignificanceTimer = 0.f;
+		UpdateSignificance();
+	}
+}
+
+/// <summary>
+/// Never ticks the class default object, the other instances ask IsTickable every frame.
+/// </summary>
+ETickableTickType UFixedCameraSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+/// <summary>
+/// Only the subsystems of game worlds tick.
+/// </summary>
+bool UFixedCameraSubsystem::IsTickable() const
+{
+	return !IsTemplate() && GetWorld() && GetWorld()->IsGameWorld();
+}
+
+/// <summary>
+/// Returns the world of the subsystem, so it only ticks with that world.
+/// </summary>
+UWorld* UFixedCameraSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+/// <summary>
+/// Returns the stat used to profile the tick of the subsystem.
+/// </summary>
+TStatId UFixedCameraSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFixedCameraSubsystem, STATGROUP_Tickables);
+}
+#pragma endregion
+
+#pragma region CLASS_EVENTS
+/// <summary>
+/// Registers a fixed camera and validates its settings (called on world begin play, BeginPlay and pooled camera reuse).
+/// </summary>
+/// <param name="Camera">Fixed camera.</param>
+void UFixedCameraSubsystem::RegisterCamera(AFixedCameraActor* Camera)
+{
+	const int32 NumCameras = Cameras.Num();
+	Cameras.AddUnique(Camera);
+	if (Cameras.Num() == NumCameras)
+		return;
+
+	Camera->ValidateFixedCamera();
+	bManagedActorsDirty = true;
+
+	// Without the registration on world begin play (UE4), cameras begin play after the default camera activated.
+	bVisibilitySetsDirty |= ActiveCamera != nullptr && Camera->bUseVisibilitySet;
+
+	const FName CameraId = Camera->GetCameraId();
+	if (CamerasById.Contains(CameraId))
+		UE_LOG(LogFixedCameraSystem, Warning, TEXT("%s: camera ID %s is already used, only the first camera is found by ID."), *Camera->GetName(), *CameraId.ToString());
+	else
+		CamerasById.Add(CameraId, Camera);
+
+	for (const FName& Tag : Camera->Tags)
+		CamerasByTag.Add(Tag, Camera);
+}
+
+/// <summary>
+/// Unregisters a fixed camera (called on EndPlay).
+/// </summary>
+/// <param name="Camera">Fixed camera.</param>
+void UFixedCameraSubsystem::UnregisterCamera(AFixedCameraActor* Camera)
+{
+	Cameras.Remove(Camera);
+	bManagedActorsDirty = true;
+
+	// Entries are removed by value, the identifier and tags may have changed since the registration.
+	FName PromotedCameraId = NAME_None;
+	for (auto It = CamerasById.CreateIterator(); It; ++It)
+	{
+		if (It.Value() == Camera)
+		{
+			PromotedCameraId = It.Key();
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = CamerasByTag.CreateIterator(); It; ++It)
+	{
+		if (It.Value() == Camera)
+			It.RemoveCurrent();
+	}
+
+	for (auto It = CamerasByZone.CreateIterator(); It; ++It)
+	{
+		if (It.Value() == Camera)
+			It.RemoveCurrent();
+	}
+
+	// The next camera with the same identifier is found by ID from now on.
+	if (!PromotedCameraId.IsNone())
+	{
+		for (AFixedCameraActor* OtherCamera : Cameras)
+		{
+			if (OtherCamera && OtherCamera->GetCameraId() == PromotedCameraId)
+			{
+				CamerasById.Add(PromotedCameraId, OtherCamera);
+				break;
+			}
+		}
+	}
+
+	UpcomingCameras.Remove(Camera);
+	CachedFrustums.Remove(Camera);
+
+	if (BlendingOutCamera == Camera)
+		BlendingOutCamera = nullptr;
+
+	if (ActiveCamera == Camera)
+		ActiveCamera = nullptr;
+}
+
+/// <summary>
+/// Called by fixed cameras when they become the view target.
+/// </summary>
+/// <param name="Camera">Activated camera.</param>
+/// <param name="fBlendTime">Blend duration.</param>
+void UFixedCameraSubsystem::NotifyCameraActivated(AFixedCameraActor* Camera, float fBlendTime)
+{
+	AFixedCameraActor* PreviousCamera = ActiveCamera;
+	ActiveCamera = Camera;
+
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	TimerManager.ClearTimer(VisibilityBlendTimer);
+
+	// Both visibility sets are shown while blending.
+	if (PreviousCamera && PreviousCamera != Camera && fBlendTime > 0.f)
+	{
+		BlendingOutCamera = PreviousCamera;
+		ApplyVisibilitySets({ PreviousCamera, Camera });
+		TimerManager.SetTimer(VisibilityBlendTimer, FTimerDelegate::CreateWeakLambda(this, [this, WeakPreviousCamera = TWeakObjectPtr<AFixedCameraActor>(PreviousCamera)]()
+		{
+			BlendingOutCamera = nullptr;
+			ApplyVisibilitySets({ ActiveCamera });
+			ApplyCameraStreaming();
+
+			AFixedCameraActor* BlendedOutCamera = WeakPreviousCamera.Get();
+			OnCameraBlendFinishedNative.Broadcast(BlendedOutCamera, ActiveCamera);
+			OnCameraBlendFinished.Broadcast(BlendedOutCamera, ActiveCamera);
+		}), fBlendTime, false);
+	}
+	else
+	{
+		BlendingOutCamera = nullptr;
+		ApplyVisibilitySets({ Camera });
+	}
+
+	UpdateUpcomingCameras();
+	ApplyCameraStreaming();
+	CacheSignificanceViews();
+	UpdateSignificance();
+	fSignificanceTimer = 0.f;
+
+	// Results of traces issued from the previous camera are dropped.
+	for (FFixedCameraOcclusionTrace& Trace : OcclusionTraces)
+		Trace.Handle = FTraceHandle();
+
+	// Listeners may activate another camera, so events are sent once the state is consistent,
+	// and the remaining ones are dropped as soon as this camera is no longer the active one.
+	const bool bBlendStarted = BlendingOutCamera != nullptr;
+
+	if (PreviousCamera && PreviousCamera != Camera)
+	{
+		OnCameraDeactivatedNative.Broadcast(PreviousCamera, Camera);
+		if (ActiveCamera != Camera)
+			return;
+
+		OnCameraDeactivated.Broadcast(PreviousCamera, Camera);
+		if (ActiveCamera != Camera)
+			return;
+	}
+
+	OnCameraActivatedNative.Broadcast(PreviousCamera, Camera);
+	if (ActiveCamera != Camera)
+		return;
+
+	OnCameraActivated.Broadcast(PreviousCamera, Camera);
+	if (!bBlendStarted || ActiveCamera != Camera)
+		return;
+
+	OnCameraBlendStartedNative.Broadcast(PreviousCamera, Camera);
+	if (ActiveCamera != Camera)
+		return;
+
+	OnCameraBlendStarted.Broadcast(PreviousCamera, Camera);
+}
+
+/// <summary>
+/// Called when a view target that is not a fixed camera replaces the active camera.
+/// </summary>
+void UFixedCameraSubsystem::NotifyCameraReleased()
+{
+	AFixedCameraActor* PreviousCamera = ActiveCamera;
+	if (!PreviousCamera)
+		return;
+
+	ActiveCamera = nullptr;
+	BlendingOutCamera = nullptr;
+	GetWorld()->GetTimerManager().ClearTimer(VisibilityBlendTimer);
+
+	// Without a fixed camera every managed actor is shown.
+	ApplyVisibilitySets({ nullptr });
+	UpdateUpcomingCameras();
+	ApplyCameraStreaming();
+	CacheSignificanceViews();
+	UpdateSignificance();
+	fSignificanceTimer = 0.f;
+
+	for (FFixedCameraOcclusionTrace& Trace : OcclusionTraces)
+		Trace.Handle = FTraceHandle();
+
+	OnCameraDeactivatedNative.Broadcast(PreviousCamera, nullptr);
+	if (!ActiveCamera)
+		OnCameraDeactivated.Broadcast(PreviousCamera, nullptr);
+}
+
+/// <summary>
+/// Saves the view of the active and blending out cameras, the running blend and the zone of every zone graph.
+/// </summary>
+FFixedCameraSnapshot UFixedCameraSubsystem::SaveSnapshot() const
+{
+	FFixedCameraSnapshot Snapshot;
+
+	auto SaveCamera = [&Snapshot](AFixedCameraActor* Camera, EFixedCameraSnapshotFlags Flags)
+	{
+		const FRotator Rotation = Camera->Camera->GetComponentRotation();
+
+		FFixedCameraSnapshotCamera& Record = Snapshot.Cameras.AddDefaulted_GetRef();
+		Record.CameraIdHash = FFixedCameraSnapshot::HashName(Camera->GetCameraId());
+		Record.Flags = (uint8)Flags;
+		Record.RailProgress = (uint16)FMath::RoundToInt(Camera->GetRailProgress() * 65535.f);
+		Record.Rotation[0] = FRotator::CompressAxisToShort(Rotation.Pitch);
+		Record.Rotation[1] = FRotator::CompressAxisToShort(Rotation.Yaw);
+		Record.Rotation[2] = FRotator::CompressAxisToShort(Rotation.Roll);
+		Record.FieldOfView = FFloat16(Camera->Camera->FieldOfView).Encoded;
+	};
+
+	if (ActiveCamera)
+		SaveCamera(ActiveCamera, EFixedCameraSnapshotFlags::Active);
+
+	if (BlendingOutCamera)
+	{
+		SaveCamera(BlendingOutCamera, EFixedCameraSnapshotFlags::BlendingOut);
+
+		const APlayerController* PlayerController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
+		const APlayerCameraManager* PlayerCameraManager = PlayerController ? PlayerController->PlayerCameraManager : nullptr;
+		if (PlayerCameraManager && PlayerCameraManager->PendingViewTarget.Target == ActiveCamera && PlayerCameraManager->BlendTimeToGo > 0.f)
+		{
+			Snapshot.bHasBlend = true;
+			Snapshot.Blend.fBlendTime = PlayerCameraManager->BlendParams.BlendTime;
+			Snapshot.Blend.fBlendTimeToGo = PlayerCameraManager->BlendTimeToGo;
+			Snapshot.Blend.fBlendExp = PlayerCameraManager->BlendParams.BlendExp;
+			Snapshot.Blend.BlendFunc = (uint8)PlayerCameraManager->BlendParams.BlendFunction.GetValue();
+		}
+	}
+
+	for (const AFixedCameraZoneGraph* ZoneGraph : ZoneGraphs)
+	{
+		FFixedCameraSnapshotZone& Record = Snapshot.Zones.AddDefaulted_GetRef();
+		Record.ZoneGraphHash = FFixedCameraSnapshot::HashName(ZoneGraph->GetFName());
+		Record.Zone = (int16)ZoneGraph->GetCurrentZone();
+	}
+
+	Snapshot.Pack();
+	return Snapshot;
+}
+
+/// <summary>
+/// Restores a saved state at once: the saved views are shown on the next frame, without smoothing from the current ones.
+/// </summary>
+/// <param name="Snapshot">Saved state.</param>
+/// <returns>False if the snapshot is not valid or its active camera is not registered.</returns>
+bool UFixedCameraSubsystem::RestoreSnapshot(FFixedCameraSnapshot Snapshot)
+{
+	if (!Snapshot.Unpack())
+		return false;
+
+	// Zones first, so the zone graphs do not switch cameras on their next update.
+	for (const FFixedCameraSnapshotZone& Record : Snapshot.Zones)
+	{
+		for (AFixedCameraZoneGraph* ZoneGraph : ZoneGraphs)
+		{
+			if (FFixedCameraSnapshot::HashName(ZoneGraph->GetFName()) == Record.ZoneGraphHash)
+			{
+				ZoneGraph->SetCurrentZone(Record.Zone);
+				break;
+			}
+		}
+	}
+
+	AFixedCameraActor* RestoredCamera = nullptr;
+	AFixedCameraActor* RestoredBlendingOutCamera = nullptr;
+
+	for (const FFixedCameraSnapshotCamera& Record : Snapshot.Cameras)
+	{
+		AFixedCameraActor* const* Camera = Cameras.FindByPredicate([&Record](const AFixedCameraActor* Candidate)
+		{
+			return FFixedCameraSnapshot::HashName(Candidate->GetCameraId()) == Record.CameraIdHash;
+		});
+
+		if (!Camera)
+		{
+			UE_LOG(LogFixedCameraSystem, Warning, TEXT("Camera snapshot references a camera that is not registered."));
+			continue;
+		}
+
+		FFloat16 FieldOfView;
+		FieldOfView.Encoded = Record.FieldOfView;
+
+		const FRotator Rotation(FRotator::DecompressAxisFromShort(Record.Rotation[0]), FRotator::DecompressAxisFromShort(Record.Rotation[1]), FRotator::DecompressAxisFromShort(Record.Rotation[2]));
+		if (!(*Camera)->RestoreFixedCameraView(Record.RailProgress / 65535.f, Rotation, FieldOfView))
+			continue;
+
+		if (EnumHasAnyFlags((EFixedCameraSnapshotFlags)Record.Flags, EFixedCameraSnapshotFlags::Active))
+			RestoredCamera = *Camera;
+		else if (EnumHasAnyFlags((EFixedCameraSnapshotFlags)Record.Flags, EFixedCameraSnapshotFlags::BlendingOut))
+			RestoredBlendingOutCamera = *Camera;
+	}
+
+	if (!RestoredCamera)
+		return false;
+
+	if (ActiveCamera && ActiveCamera != RestoredCamera && ActiveCamera != RestoredBlendingOutCamera)
+		ActiveCamera->DeactivateFixedCamera();
+
+	// The blend is started again and moved forward to the saved time.
+	if (Snapshot.bHasBlend && RestoredBlendingOutCamera && RestoredBlendingOutCamera != RestoredCamera)
+	{
+		RestoredBlendingOutCamera->ActivateFixedCamera(0.f, VTBlend_Linear, 0.f);
+		RestoredCamera->ActivateFixedCamera(Snapshot.Blend.fBlendTime, (EViewTargetBlendFunction)Snapshot.Blend.BlendFunc, Snapshot.Blend.fBlendExp);
+
+		APlayerController* PlayerController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
+		if (PlayerController && PlayerController->PlayerCameraManager)
+			PlayerController->PlayerCameraManager->BlendTimeToGo = FMath::Min(Snapshot.Blend.fBlendTimeToGo, Snapshot.Blend.fBlendTime);
+	}
+	else
+	{
+		RestoredCamera->ActivateFixedCamera(0.f, VTBlend_Linear, 0.f);
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Starts recording the final camera view, the active camera and the camera switches, clearing the previous recording.
+/// </summary>
+/// <param name="fMaxDuration">Seconds kept, older frames are overwritten.</param>
+/// <param name="fSampleRate">Recorded frames per second (camera switches are always recorded).</param>
+/// <param name="fKeyframeInterval">Seconds between keyframes (longer intervals use less memory and sample slower).</param>
+void UFixedCameraSubsystem::StartRecording(float fMaxDuration, float fSampleRate, float fKeyframeInterval)
+{
+	Recorder.Start(fMaxDuration, fSampleRate, fKeyframeInterval);
+
+	// Subsystems tick before the camera managers, so the view is recorded once the actors have ticked.
+	if (!RecordingTickHandle.IsValid())
+		RecordingTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UFixedCameraSubsystem::RecordCameraView);
+}
+
+/// <summary>
+/// Stops recording, keeping the recorded frames.
+/// </summary>
+void UFixedCameraSubsystem::StopRecording()
+{
+	Recorder.Stop();
+
+	FWorldDelegates::OnWorldPostActorTick.Remove(RecordingTickHandle);
+	RecordingTickHandle.Reset();
+
+	UE_LOG(LogFixedCameraSystem, Verbose, TEXT("Camera recording stopped (%d bytes)."), Recorder.GetRecordedSize());
+}
+
+/// <summary>
+/// Returns true while the camera view is recorded.
+/// </summary>
+bool UFixedCameraSubsystem::IsRecording() const
+{
+	return Recorder.IsRecording();
+}
+
+/// <summary>
+/// Returns the world time of the first and last recorded frames.
+/// </summary>
+/// <returns>False if nothing is recorded.</returns>
+bool UFixedCameraSubsystem::GetRecordingTimeRange(float& OutStartTime, float& OutEndTime) const
+{
+	return Recorder.GetTimeRange(OutStartTime, OutEndTime);
+}
+
+/// <summary>
+/// Returns the recorded camera view at a world time, without evaluating any camera.
+/// </summary>
+/// <param name="fTime">World time (clamped to the recorded range).</param>
+/// <returns>False if nothing is recorded.</returns>
+bool UFixedCameraSubsystem::SampleRecording(float fTime, FVector& OutLocation, FRotator& OutRotation, float& OutFieldOfView, FName& OutCameraId) const
+{
+	return Recorder.Sample(fTime, OutLocation, OutRotation, OutFieldOfView, OutCameraId);
+}
+
+/// <summary>
+/// Returns the camera switches recorded in a world time range.
+/// </summary>
+/// <param name="fStartTime">Range start.</param>
+/// <param name="fEndTime">Range end.</param>
+/// <param name="OutSwitches">Camera switches, in time order.</param>
+void UFixedCameraSubsystem::GetRecordedSwitches(float fStartTime, float fEndTime, TArray<FFixedCameraRecordedSwitch>& OutSwitches) const
+{
+	Recorder.GetSwitches(fStartTime, fEndTime, OutSwitches);
+}
+
+/// <summary>
+/// Returns the bytes used by the recorded frames.
+/// </summary>
+int32 UFixedCameraSubsystem::GetRecordingSize() const
+{
+	return Recorder.GetRecordedSize();
+}
+
+/// <summary>
+/// Records the camera view computed by the player camera manager this frame (called after the actors tick while recording).
+/// </summary>
+/// <param name="InWorld">Ticked world.</param>
+/// <param name="TickType">Tick type.</param>
+/// <param name="DeltaTime">Time between frames.</param>
+void UFixedCameraSubsystem::RecordCameraView(UWorld* InWorld, ELevelTick TickType, float DeltaTime)
+{
+	if (InWorld != GetWorld() || !Recorder.IsRecording())
+		return;
+
+	// The camera managers are updated after every tick group, so the view and the active camera match.
+	const APlayerController* PlayerController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
+	const APlayerCameraManager* PlayerCameraManager = PlayerController ? PlayerController->PlayerCameraManager : nullptr;
+	if (!PlayerCameraManager)
+		return;
+
+	// The final view includes blends, so replays need no camera logic.
+	Recorder.Record(GetWorld()->GetTimeSeconds(), PlayerCameraManager->GetCameraLocation(), PlayerCameraManager->GetCameraRotation(), PlayerCameraManager->GetFOVAngle(), ActiveCamera ? ActiveCamera->GetCameraId() : NAME_None);
+}
+
+/// <summary>
+/// Called by zone graphs when the player enters another zone.
+/// </summary>
+/// <param name="ZoneGraph">Zone graph.</param>
+/// <param name="PreviousZone">Left zone (INDEX_NONE on the first zone).</param>
+/// <param name="NextZone">Entered zone.</param>
+void UFixedCameraSubsystem::NotifyZoneChanged(AFixedCameraZoneGraph* ZoneGraph, int32 PreviousZone, int32 NextZone)
+{
+	OnZoneChangedNative.Broadcast(ZoneGraph, PreviousZone, NextZone);
+	OnZoneChanged.Broadcast(ZoneGraph, PreviousZone, NextZone);
+}
+
+/// <summary>
+/// Returns the last activated fixed camera.
+/// </summary>
+AFixedCameraActor* UFixedCameraSubsystem::GetActiveCamera() const
+{
+	return ActiveCamera;
+}
+
+/// <summary>
+/// Returns true if geometry is between the active camera and the player (one frame latency).
+/// </summary>
+bool UFixedCameraSubsystem::IsPlayerOccluded() const
+{
+	return OcclusionTraces[0].bOccluded;
+}
+
+/// <summary>
+/// Returns true if geometry is between the active camera and its focus target (one frame latency).
+/// </summary>
+bool UFixedCameraSubsystem::IsFocusTargetOccluded() const
+{
+	return OcclusionTraces[1].bOccluded;
+}
+
+/// <summary>
+/// Returns the actors blocking the view of the player and the focus target.
+/// </summary>
+/// <param name="OutOccluders">Occluding actors.</param>
+void UFixedCameraSubsystem::GetOccluders(TArray<AActor*>& OutOccluders) const
+{
+	OutOccluders.Reset();
+
+	for (const FFixedCameraOcclusionTrace& Trace : OcclusionTraces)
+	{
+		for (const TWeakObjectPtr<AActor>& Occluder : Trace.Occluders)
+		{
+			if (Occluder.IsValid())
+				OutOccluders.AddUnique(Occluder.Get());
+		}
+	}
+}
+
+/// <summary>
+/// Consumes last frame occlusion traces and issues the new ones (called every frame).
+/// </summary>
+void UFixedCameraSubsystem::UpdateOcclusion()
+{
+	UWorld* World = GetWorld();
+
+	// Consume the traces issued last frame.
+	for (FFixedCameraOcclusionTrace& Trace : OcclusionTraces)
+	{
+		FTraceDatum TraceDatum;
+		if (!Trace.Handle.IsValid() || !World->QueryTraceData(Trace.Handle, TraceDatum))
+			continue;
+
+		Trace.Handle = FTraceHandle();
+		Trace.Occluders.Reset();
+		for (const FHitResult& Hit : TraceDatum.OutHits)
+		{
+			if (Hit.bBlockingHit && Hit.GetActor())
+				Trace.Occluders.AddUnique(Hit.GetActor());
+		}
+
+		const bool bOccluded = Trace.Occluders.Num() > 0;
+		if (bOccluded != Trace.bOccluded)
+		{
+			Trace.bOccluded = bOccluded;
+			OnOcclusionChanged.Broadcast(Trace.Target.Get(), bOccluded);
+		}
+	}
+
+	// Issue this frame traces, both in the same batch.
+	AActor* PlayerCharacter = nullptr;
+	AActor* FocusTarget = nullptr;
+	if (ActiveCamera && ActiveCamera->bTraceOcclusion)
+	{
+		PlayerCharacter = UGameplayStatics::GetPlayerCharacter(World, 0);
+		if (ActiveCamera->GetCameraFocus() == ECameraFocus::FocusOnObject || ActiveCamera->GetCameraFocus() == ECameraFocus::MiddleLocationPlayerAndObject)
+			FocusTarget = ActiveCamera->FocusTarget;
+	}
+
+	SetOcclusionTarget(OcclusionTraces[0], PlayerCharacter);
+	SetOcclusionTarget(OcclusionTraces[1], FocusTarget);
+
+	if (!PlayerCharacter && !FocusTarget)
+		return;
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FixedCameraOcclusion), false);
+	QueryParams.AddIgnoredActor(ActiveCamera);
+	QueryParams.AddIgnoredActor(PlayerCharacter);
+	QueryParams.AddIgnoredActor(FocusTarget);
+
+	const FVector TraceStart = ActiveCamera->Camera->GetComponentLocation();
+
+	for (FFixedCameraOcclusionTrace& Trace : OcclusionTraces)
+	{
+		if (Trace.Target.IsValid())
+			Trace.Handle = World->AsyncLineTraceByChannel(EAsyncTraceType::Multi, TraceStart, Trace.Target->GetActorLocation(), ActiveCamera->OcclusionChannel, QueryParams);
+	}
+}
+
+/// <summary>
+/// Sets the target of an occlusion trace, clearing its state when the target changes.
+/// </summary>
+/// <param name="Trace">Occlusion trace.</param>
+/// <param name="Target">New target.</param>
+void UFixedCameraSubsystem::SetOcclusionTarget(FFixedCameraOcclusionTrace& Trace, AActor* Target)
+{
+	if (Trace.Target.Get() == Target)
+		return;
+
+	if (Trace.bOccluded)
+		OnOcclusionChanged.Broadcast(Trace.Target.Get(), false);
+
+	Trace.Target = Target;
+	Trace.Handle = FTraceHandle();
+	Trace.bOccluded = false;
+	Trace.Occluders.Reset();
+}
+
+/// <summary>
+/// Returns the registered camera with the given identifier.
+/// </summary>
+/// <param name="CameraId">Camera identifier.</param>
+AFixedCameraActor* UFixedCameraSubsystem::FindCameraById(FName CameraId) const
+{
+	return CamerasById.FindRef(CameraId).Get();
+}
+
+/// <summary>
+/// Returns the cameras with an actor tag.
+/// </summary>
+/// <param name="Tag">Actor tag.</param>
+TArray<AFixedCameraActor*> UFixedCameraSubsystem::FindCamerasByTag(FName Tag) const
+{
+	TArray<AFixedCameraActor*> TaggedCameras;
+	for (auto It = CamerasByTag.CreateConstKeyIterator(Tag); It; ++It)
+	{
+		if (AFixedCameraActor* TaggedCamera = It.Value().Get())
+			TaggedCameras.Add(TaggedCamera);
+	}
+	return TaggedCameras;
+}
+
+/// <summary>
+/// Returns the camera of a zone graph zone, or nullptr if no zone has this name.
+/// </summary>
+/// <param name="ZoneName">Zone name.</param>
+AFixedCameraActor* UFixedCameraSubsystem::FindCameraByZone(FName ZoneName) const
+{
+	return CamerasByZone.FindRef(ZoneName).Get();
+}
+
+/// <summary>
+/// Returns the cached frustum of a camera (the active camera if None), or nullptr if the camera does not exist.
+/// </summary>
+/// <param name="CameraId">Camera identifier.</param>
+const FFixedCameraFrustum* UFixedCameraSubsystem::GetViewFrustum(FName CameraId) const
+{
+	AFixedCameraActor* Camera = CameraId.IsNone() ? ActiveCamera : FindCameraById(CameraId);
+	if (!Camera)
+		return nullptr;
+
+	// Rebuilt only when the view changed since the last query.
+	FFixedCameraCachedFrustum& CachedFrustum = CachedFrustums.FindOrAdd(Camera);
+	const FTransform& ViewTransform = Camera->Camera->GetComponentTransform();
+
+	if (!CachedFrustum.Frustum.IsValid()
+		|| !CachedFrustum.ViewTransform.Equals(ViewTransform, KINDA_SMALL_NUMBER)
+		|| CachedFrustum.fFieldOfView != Camera->Camera->FieldOfView
+		|| CachedFrustum.fAspectRatio != Camera->Camera->AspectRatio)
+	{
+		FConvexVolume Volume;
+		GetCameraFrustum(Camera, Volume);
+
+		CachedFrustum.Frustum.Build(Volume);
+		CachedFrustum.ViewTransform = ViewTransform;
+		CachedFrustum.fFieldOfView = Camera->Camera->FieldOfView;
+		CachedFrustum.fAspectRatio = Camera->Camera->AspectRatio;
+	}
+
+	return &CachedFrustum.Frustum;
+}
+
+/// <summary>
+/// Returns true if the point is inside the view of a camera (the active camera if None).
+/// </summary>
+/// <param name="Point">World location.</param>
+/// <param name="CameraId">Camera identifier.</param>
+bool UFixedCameraSubsystem::IsPointInView(const FVector& Point, FName CameraId) const
+{
+	const FFixedCameraFrustum* Frustum = GetViewFrustum(CameraId);
+	return Frustum && Frustum->ContainsPoint(Point);
+}
+
+/// <summary>
+/// Returns true if the sphere intersects the view of a camera (the active camera if None).
+/// </summary>
+/// <param name="Center">Sphere center.</param>
+/// <param name="Radius">Sphere radius.</param>
+/// <param name="CameraId">Camera identifier.</param>
+bool UFixedCameraSubsystem::IsSphereInView(const FVector& Center, float Radius, FName CameraId) const
+{
+	const FFixedCameraFrustum* Frustum = GetViewFrustum(CameraId);
+	return Frustum && Frustum->IntersectsSphere(Center, Radius);
+}
+
+/// <summary>
+/// Returns true if the box intersects the view of a camera (the active camera if None).
+/// </summary>
+/// <param name="Box">World box.</param>
+/// <param name="CameraId">Camera identifier.</param>
+bool UFixedCameraSubsystem::IsBoxInView(const FBox& Box, FName CameraId) const
+{
+	const FFixedCameraFrustum* Frustum = GetViewFrustum(CameraId);
+	return Frustum && Frustum->IntersectsBox(Box);
+}
+
+/// <summary>
+/// Batched point test against the view of a camera (the active camera if None). Results are false if the camera does not exist.
+/// </summary>
+/// <param name="Points">World locations.</param>
+/// <param name="OutInView">Result per point. Must have the same size as Points.</param>
+/// <param name="CameraId">Camera identifier.</param>
+void UFixedCameraSubsystem::ArePointsInView(TArrayView<const FVector> Points, TArrayView<bool> OutInView, FName CameraId) const
+{
+	if (const FFixedCameraFrustum* Frustum = GetViewFrustum(CameraId))
+		Frustum->ContainsPoints(Points, OutInView);
+	else
+		FMemory::Memzero(OutInView.GetData(), OutInView.Num() * sizeof(bool));
+}
+
+/// <summary>
+/// Batched sphere test against the view of a camera (the active camera if None). Results are false if the camera does not exist.
+/// </summary>
+/// <param name="Centers">Sphere centers.</param>
+/// <param name="Radii">Sphere radii.</param>
+/// <param name="OutInView">Result per sphere. Must have the same size as Centers.</param>
+/// <param name="CameraId">Camera identifier.</param>
+void UFixedCameraSubsystem::AreSpheresInView(TArrayView<const FVector> Centers, TArrayView<const float> Radii, TArrayView<bool> OutInView, FName CameraId) const
+{
+	if (const FFixedCameraFrustum* Frustum = GetViewFrustum(CameraId))
+		Frustum->IntersectsSpheres(Centers, Radii, OutInView);
+	else
+		FMemory::Memzero(OutInView.GetData(), OutInView.Num() * sizeof(bool));
+}
+
+/// <summary>
+/// Batched box test against the view of a camera (the active camera if None). Results are false if the camera does not exist.
+/// </summary>
+/// <param name="Boxes">World boxes.</param>
+/// <param name="OutInView">Result per box. Must have the same size as Boxes.</param>
+/// <param name="CameraId">Camera identifier.</param>
+void UFixedCameraSubsystem::AreBoxesInView(TArrayView<const FBox> Boxes, TArrayView<bool> OutInView, FName CameraId) const
+{
+	if (const FFixedCameraFrustum* Frustum = GetViewFrustum(CameraId))
+		Frustum->IntersectsBoxes(Boxes, OutInView);
+	else
+		FMemory::Memzero(OutInView.GetData(), OutInView.Num() * sizeof(bool));
+}
+
+/// <summary>
+/// Registers a zone graph (called on BeginPlay).
+/// </summary>
+/// <param name="ZoneGraph">Zone graph.</param>
+void UFixedCameraSubsystem::RegisterZoneGraph(AFixedCameraZoneGraph* ZoneGraph)
+{
+	const int32 NumZoneGraphs = ZoneGraphs.Num();
+	ZoneGraphs.AddUnique(ZoneGraph);
+	if (ZoneGraphs.Num() == NumZoneGraphs)
+		return;
+
+	bUpcomingCamerasDirty = ActiveCamera != nullptr;
+
+	for (const FFixedCameraZone& Zone : ZoneGraph->Zones)
+	{
+		if (!Zone.ZoneName.IsNone() && Zone.Camera)
+			CamerasByZone.Add(Zone.ZoneName, Zone.Camera);
+	}
+}
+
+/// <summary>
+/// Unregisters a zone graph (called on EndPlay).
+/// </summary>
+/// <param name="ZoneGraph">Zone graph.</param>
+void UFixedCameraSubsystem::UnregisterZoneGraph(AFixedCameraZoneGraph* ZoneGraph)
+{
+	ZoneGraphs.Remove(ZoneGraph);
+
+	for (const FFixedCameraZone& Zone : ZoneGraph->Zones)
+	{
+		if (CamerasByZone.FindRef(Zone.ZoneName).Get() == Zone.Camera)
+			CamerasByZone.Remove(Zone.ZoneName);
+	}
+
+	ActiveZones.RemoveAll([ZoneGraph](const TPair<AFixedCameraZoneGraph*, int32>& Zone) { return Zone.Key == ZoneGraph; });
+}
+
+/// <summary>
+/// Registers a trigger (called on BeginPlay).
+/// </summary>
+/// <param name="Trigger">Fixed camera trigger.</param>
+void UFixedCameraSubsystem::RegisterTrigger(AFixedCameraTrigger* Trigger)
+{
+	Triggers.AddUnique(Trigger);
+	bUpcomingCamerasDirty = ActiveCamera != nullptr;
+}
+
+/// <summary>
+/// Unregisters a trigger (called on EndPlay).
+/// </summary>
+/// <param name="Trigger">Fixed camera trigger.</param>
+void UFixedCameraSubsystem::UnregisterTrigger(AFixedCameraTrigger* Trigger)
+{
+	Triggers.Remove(Trigger);
+}
+
+/// <summary>
+/// Registers a significance component (called on BeginPlay).
+/// </summary>
+/// <param name="Component">Significance component.</param>
+void UFixedCameraSubsystem::RegisterSignificanceComponent(UFixedCameraSignificanceComponent* Component)
+{
+	SignificanceComponents.AddUnique(Component);
+
+	// The views are not cached while no component is registered.
+	bSignificanceViewsDirty |= ActiveCamera != nullptr;
+}
+
+/// <summary>
+/// Unregisters a significance component (called on EndPlay).
+/// </summary>
+/// <param name="Component">Significance component.</param>
+void UFixedCameraSubsystem::UnregisterSignificanceComponent(UFixedCameraSignificanceComponent* Component)
+{
+	SignificanceComponents.RemoveSwap(Component);
+}
+
+/// <summary>
+/// Returns the cameras reachable from a camera through every zone graph and trigger.
+/// </summary>
+/// <param name="Camera">Fixed camera.</param>
+/// <param name="OutCameras">Adjacent cameras.</param>
+void UFixedCameraSubsystem::GetAdjacentCameras(const AFixedCameraActor* Camera, TArray<AFixedCameraActor*>& OutCameras) const
+{
+	OutCameras.Reset();
+
+	for (const AFixedCameraZoneGraph* ZoneGraph : ZoneGraphs)
+	{
+		if (ZoneGraph)
+			ZoneGraph->GetAdjacentCameras(Camera, OutCameras);
+	}
+
+	// A trigger links its two cameras.
+	for (const AFixedCameraTrigger* Trigger : Triggers)
+	{
+		if (!Trigger)
+			continue;
+
+		if (Trigger->Camera1 == Camera && Trigger->Camera2)
+			OutCameras.AddUnique(Trigger->Camera2);
+		else if (Trigger->Camera2 == Camera && Trigger->Camera1)
+			OutCameras.AddUnique(Trigger->Camera1);
+	}
+}
+
+/// <summary>
+/// Enables the streaming sources and loads the sublevels of the active, blending out and upcoming cameras.
+/// Everything else owned by the cameras is disabled or unloaded.
+/// </summary>
+void UFixedCameraSubsystem::ApplyCameraStreaming()
+{
+	// Sublevel package -> visible (active or blending out) or only loaded (upcoming).
+	TMap<FName, bool> RequiredSublevels;
+
+	for (AFixedCameraActor* Camera : Cameras)
+	{
+		if (!Camera)
+			continue;
+
+		const bool bInView = Camera == ActiveCamera || Camera == BlendingOutCamera;
+		const bool bUpcoming = !bInView && UpcomingCameras.Contains(Camera);
+
+		if (Camera->bIsStreamingSource)
+			Camera->SetStreamingSourceEnabled(bInView || (bUpcoming && Camera->bStreamingSourceWhenUpcoming));
+
+		if (!bInView && !(bUpcoming && Camera->bPreloadSublevelsWhenUpcoming))
+			continue;
+
+		for (const TSoftObjectPtr<UWorld>& Sublevel : Camera->Sublevels)
+		{
+			if (Sublevel.IsNull())
+				continue;
+
+			bool& bVisible = RequiredSublevels.FindOrAdd(FName(*Sublevel.GetLongPackageName()));
+			bVisible |= bInView;
+		}
+	}
+
+	for (const TPair<FName, bool>& Sublevel : RequiredSublevels)
+	{
+		if (ULevelStreaming* LevelStreaming = UGameplayStatics::GetStreamingLevel(GetWorld(), Sublevel.Key))
+		{
+			LevelStreaming->SetShouldBeLoaded(true);
+			LevelStreaming->SetShouldBeVisible(Sublevel.Value);
+			LoadedSublevels.Add(Sublevel.Key);
+		}
+	}
+
+	for (auto It = LoadedSublevels.CreateIterator(); It; ++It)
+	{
+		if (RequiredSublevels.Contains(*It))
+			continue;
+
+		if (ULevelStreaming* LevelStreaming = UGameplayStatics::GetStreamingLevel(GetWorld(), *It))
+		{
+			LevelStreaming->SetShouldBeVisible(false);
+			LevelStreaming->SetShouldBeLoaded(false);
+		}
+		It.RemoveCurrent();
+	}
+}
+
+/// <summary>
+/// Gathers the cameras reachable from the active camera and prefetches the new ones.
+/// </summary>
+void UFixedCameraSubsystem::UpdateUpcomingCameras()
+{
+	bUpcomingCamerasDirty = false;
+
+	// Cameras that were not upcoming before are prefetched once.
+	TArray<AFixedCameraActor*> PreviousUpcomingCameras = MoveTemp(UpcomingCameras);
+	UpcomingCameras.Reset();
+
+	if (!ActiveCamera)
+		return;
+
+	GetAdjacentCameras(ActiveCamera, UpcomingCameras);
+	UpcomingCameras.Remove(ActiveCamera);
+
+	for (AFixedCameraActor* UpcomingCamera : UpcomingCameras)
+	{
+		if (!PreviousUpcomingCameras.Contains(UpcomingCamera))
+			PrefetchCamera(UpcomingCamera);
+	}
+}
+
+/// <summary>
+/// Registers the upcoming cameras as additional streaming views (called every frame).
+/// </summary>
+void UFixedCameraSubsystem::AddUpcomingStreamingViews()
+{
+	for (const AFixedCameraActor* UpcomingCamera : UpcomingCameras)
+	{
+		if (UpcomingCamera && UpcomingCamera->bStreamWhenUpcoming)
+			AddStreamingView(UpcomingCamera, 0.f);
+	}
+
+	// The blend only reaches the target view at the end, so the target is streamed as well.
+	if (ActiveCamera && GetWorld()->GetTimerManager().IsTimerActive(VisibilityBlendTimer))
+		AddStreamingView(ActiveCamera, 0.f);
+}
+
+/// <summary>
+/// Prefetches the content seen by a camera that just became upcoming.
+/// </summary>
+/// <param name="Camera">Upcoming camera.</param>
+void UFixedCameraSubsystem::PrefetchCamera(AFixedCameraActor* Camera)
+{
+	if (!Camera || !Camera->bStreamWhenUpcoming || !Camera->bPrefetchWhenUpcoming || Camera->fPrefetchDuration <= 0.f)
+		return;
+
+	AddStreamingView(Camera, Camera->fPrefetchDuration);
+
+	// Baked visibility sets tell exactly which textures the camera needs.
+	if (Camera->bUseVisibilitySet)
+	{
+		for (AActor* Actor : Camera->VisibilitySet)
+		{
+			if (IsValid(Actor))
+				Actor->PrestreamTextures(Camera->fPrefetchDuration, true);
+		}
+	}
+}
+
+/// <summary>
+/// Adds a camera as a streaming view origin.
+/// </summary>
+/// <param name="Camera">Fixed camera.</param>
+/// <param name="fDuration">Seconds the view is kept (0 for this frame only).</param>
+void UFixedCameraSubsystem::AddStreamingView(const AFixedCameraActor* Camera, float fDuration)
+{
+	float fScreenSize = 1920.f;
+	if (GEngine && GEngine->GameViewport)
+	{
+		FVector2D ViewportSize;
+		GEngine->GameViewport->GetViewportSize(ViewportSize);
+		if (ViewportSize.X > 0.f)
+			fScreenSize = ViewportSize.X;
+	}
+
+	// Same screen size as the main view, so the streaming pool is shared rather than raised.
+	const float fHalfFOV = FMath::DegreesToRadians(FMath::Clamp(Camera->Camera->FieldOfView, 1.f, 170.f) * 0.5f);
+	IStreamingManager::Get().AddViewInformation(Camera->Camera->GetComponentLocation(), fScreenSize, fScreenSize / FMath::Tan(fHalfFOV), 1.f, false, fDuration);
+}
+
+/// <summary>
+/// Builds the current view frustum of a fixed camera.
+/// </summary>
+/// <param name="Camera">Fixed camera.</param>
+/// <param name="OutFrustum">View frustum.</param>
+void UFixedCameraSubsystem::GetCameraFrustum(const AFixedCameraActor* Camera, FConvexVolume& OutFrustum)
+{
+	FMinimalViewInfo ViewInfo;
+	Camera->Camera->GetCameraView(0.f, ViewInfo);
+
+	FMatrix ViewMatrix;
+	FMatrix ProjectionMatrix;
+	FMatrix ViewProjectionMatrix;
+	UGameplayStatics::GetViewProjectionMatrix(ViewInfo, ViewMatrix, ProjectionMatrix, ViewProjectionMatrix);
+
+	GetViewFrustumBounds(OutFrustum, ViewProjectionMatrix, false);
+}
+
+/// <summary>
+/// Caches the zones and adjacent frustums of the active camera.
+/// </summary>
+void UFixedCameraSubsystem::CacheSignificanceViews()
+{
+	ActiveZones.Reset();
+	AdjacentFrustums.Reset();
+
+	if (!ActiveCamera || SignificanceComponents.Num() == 0)
+		return;
+
+	TArray<int32> CameraZones;
+	for (AFixedCameraZoneGraph* ZoneGraph : ZoneGraphs)
+	{
+		if (!ZoneGraph)
+			continue;
+
+		ZoneGraph->GetCameraZones(ActiveCamera, CameraZones);
+		for (int32 ZoneIndex : CameraZones)
+			ActiveZones.Emplace(ZoneGraph, ZoneIndex);
+	}
+
+	// Cameras the player can reach next, so their actors are promoted before the switch.
+	for (const AFixedCameraActor* UpcomingCamera : UpcomingCameras)
+	{
+		if (UpcomingCamera)
+			GetCameraFrustum(UpcomingCamera, AdjacentFrustums.AddDefaulted_GetRef());
+	}
+}
+
+/// <summary>
+/// Updates the significance of every registered component.
+/// </summary>
+void UFixedCameraSubsystem::UpdateSignificance()
+{
+	if (SignificanceComponents.Num() == 0)
+		return;
+
+	// Focus and rail cameras move, so only the active frustum is rebuilt on every update.
+	if (ActiveCamera)
+		GetCameraFrustum(ActiveCamera, ActiveFrustum);
+
+	for (UFixedCameraSignificanceComponent* Component : SignificanceComponents)
+	{
+		const USceneComponent* OwnerRoot = Component && Component->GetOwner() ? Component->GetOwner()->GetRootComponent() : nullptr;
+		if (!OwnerRoot)
+			continue;
+
+		const FVector Origin = OwnerRoot->Bounds.Origin;
+		const float Radius = OwnerRoot->Bounds.SphereRadius;
+
+		EFixedCameraSignificance Significance = EFixedCameraSignificance::Insignificant;
+
+		if (!ActiveCamera)
+		{
+			Significance = EFixedCameraSignificance::Visible;
+		}
+		else if (ActiveFrustum.IntersectSphere(Origin, Radius))
+		{
+			// Inside the frustum, and inside one of the camera zones when the camera owns zones.
+			bool bInActiveZone = ActiveZones.Num() == 0;
+			for (const TPair<AFixedCameraZoneGraph*, int32>& Zone : ActiveZones)
+			{
+				if (Zone.Key->IsInZone(Zone.Value, Origin))
+				{
+					bInActiveZone = true;
+					break;
+				}
+			}
+
+			if (bInActiveZone)
+				Significance = EFixedCameraSignificance::Visible;
+		}
+
+		if (Significance == EFixedCameraSignificance::Insignificant)
+		{
+			for (const FConvexVolume& AdjacentFrustum : AdjacentFrustums)
+			{
+				if (AdjacentFrustum.IntersectSphere(Origin, Radius))
+				{
+					Significance = EFixedCameraSignificance::Upcoming;
+					break;
+				}
+			}
+		}
+
+		Component->SetSignificance(Significance);
+	}
+}
+
+/// <summary>
+/// Shows the actors of the given cameras and hides the rest of the managed actors.
+/// </summary>
+/// <param name="VisibleCameras">Cameras whose visibility sets are shown.</param>
+void UFixedCameraSubsystem::ApplyVisibilitySets(const TArray<AFixedCameraActor*>& VisibleCameras)
+{
+	if (bManagedActorsDirty)
+	{
+		ManagedActors.Reset();
+		for (const AFixedCameraActor* Camera : Cameras)
+		{
+			if (Camera && Camera->bUseVisibilitySet)
+				ManagedActors.Append(Camera->VisibilitySet);
+		}
+		ManagedActors.Remove(nullptr);
+		bManagedActorsDirty = false;
+	}
+
+	if (ManagedActors.Num() == 0)
+		return;
+
+	// A camera without a visibility set shows every managed actor.
+	TSet<AActor*> VisibleActors;
+	bool bShowAll = false;
+	bool bDisableTick = false;
+
+	for (const AFixedCameraActor* Camera : VisibleCameras)
+	{
+		if (!Camera || !Camera->bUseVisibilitySet)
+		{
+			bShowAll = true;
+			break;
+		}
+
+		VisibleActors.Append(Camera->VisibilitySet);
+		bDisableTick |= Camera->bDisableTickOutsideView;
+	}
+
+	for (AActor* Actor : ManagedActors)
+	{
+		if (!IsValid(Actor))
+			continue;
+
+		const bool bHide = !bShowAll && !VisibleActors.Contains(Actor);
+		if (bHide == HiddenActors.Contains(Actor))
+			continue;
+
+		Actor->SetActorHiddenInGame(bHide);
+
+		if (bHide)
+		{
+			HiddenActors.Add(Actor);
+			if (bDisableTick && Actor->IsActorTickEnabled())
+			{
+				Actor->SetActorTickEnabled(false);
+				TickDisabledActors.Add(Actor);
+			}
+		}
+		else
+		{
+			HiddenActors.Remove(Actor);
+			if (TickDisabledActors.Remove(Actor) > 0)
+				Actor->SetActorTickEnabled(true);
+		}
+	}
+}
+#pragma endregion
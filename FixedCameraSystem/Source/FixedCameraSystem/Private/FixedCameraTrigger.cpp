@@ -1,7 +1,15 @@
 // Copyright 2023 German Lopez. All Rights Reserved.
 
 #include "FixedCameraTrigger.h"
+#include "FixedCameraSystem.h"
+#include "FixedCameraSubsystem.h"
 #include "UObject/ConstructorHelpers.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#if FIXEDCAMERA_WITH_ASYNC_PHYSICS_TICK
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
+#endif
 
 #pragma region UNREAL_ENGINE_EVENTS
 /// <summary>
@@ -9,8 +17,14 @@
 /// </summary>
 AFixedCameraTrigger::AFixedCameraTrigger()
 {
+	// Switches posted by the async physics tick are applied by the subsystem.
 	PrimaryActorTick.bCanEverTick = false;
 
+	AsyncStateSequence = 0;
+	bPlayerInTrigger1 = false;
+	bPlayerInTrigger2 = false;
+	PhysicsStateSequence = 0;
+
 	Root = CreateDefaultSubobject<USceneComponent>("Root Component");
 
 	RootComponent = Root;
@@ -68,10 +82,8 @@ AFixedCameraTrigger::AFixedCameraTrigger()
 /// <param name="Transform"></param>
 void AFixedCameraTrigger::OnConstruction(const FTransform& Transform)
 {
-	SetActorScale3D(FVector(.1f, GetActorScale3D().Y, GetActorScale3D().Z));
+	LayoutTriggers();
 
-	Trigger1->SetRelativeLocation(FVector(-Trigger1->GetCollisionShape().GetExtent().X / GetActorScale3D().X, Trigger1->GetCollisionShape().GetExtent().Y / GetActorScale3D().Y, Trigger1->GetCollisionShape().GetExtent().Z / GetActorScale3D().Z));
-	Trigger2->SetRelativeLocation(FVector(Trigger2->GetCollisionShape().GetExtent().X / GetActorScale3D().X, Trigger1->GetCollisionShape().GetExtent().Y / GetActorScale3D().Y, Trigger2->GetCollisionShape().GetExtent().Z / GetActorScale3D().Z));
 	#if WITH_EDITOR
 		if (GEngine)
 		{
@@ -101,6 +113,25 @@ void AFixedCameraTrigger::BeginPlay()
 
 	DebugCollider1->SetVisibility(false);
 	DebugCollider2->SetVisibility(false);
+
+	GetWorld()->GetSubsystem<UFixedCameraSubsystem>()->RegisterTrigger(this);
+
+	if (bEvaluateOnAsyncPhysicsTick)
+		StartAsyncPhysicsEvaluation();
+}
+
+/// <summary>
+/// Called when the actor is removed from the level.
+/// </summary>
+/// <param name="EndPlayReason">End play reason.</param>
+void AFixedCameraTrigger::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ReleasePlayer();
+
+	if (UFixedCameraSubsystem* FixedCameraSubsystem = GetWorld()->GetSubsystem<UFixedCameraSubsystem>())
+		FixedCameraSubsystem->UnregisterTrigger(this);
+
+	Super::EndPlay(EndPlayReason);
 }
 
 /// <summary>
@@ -111,6 +142,61 @@ void AFixedCameraTrigger::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 }
+
+#if FIXEDCAMERA_WITH_ASYNC_PHYSICS_TICK
+/// <summary>
+/// Called on the physics thread at the fixed physics step.
+/// </summary>
+/// <param name="DeltaTime">Physics step.</param>
+/// <param name="SimTime">Simulation time.</param>
+void AFixedCameraTrigger::AsyncPhysicsTickActor(float DeltaTime, float SimTime)
+{
+	Super::AsyncPhysicsTickActor(DeltaTime, SimTime);
+
+	// Lock-free read of the published state: a copy made while the game thread writes is discarded.
+	const uint32 Sequence = AsyncStateSequence.load(std::memory_order_acquire);
+	if (Sequence == 0 || (Sequence & 1) != 0)
+		return;
+
+	const FFixedCameraTriggerAsyncState State = AsyncState;
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (AsyncStateSequence.load(std::memory_order_relaxed) != Sequence)
+		return;
+
+	// The player body is read at this physics step, never through its game thread components.
+	Chaos::FRigidBodyHandle_Internal* PlayerBody = State.PlayerProxy ? State.PlayerProxy->GetPhysicsThreadAPI() : nullptr;
+	if (!PlayerBody)
+		return;
+
+#if ENGINE_MINOR_VERSION >= 4
+	const FVector PlayerLocation = PlayerBody->GetX();
+#else
+	const FVector PlayerLocation = PlayerBody->X();
+#endif
+
+	const bool bInTrigger1 = IsInTriggerBox(State.Trigger1Transform, State.Trigger1Extent, PlayerLocation);
+	const bool bInTrigger2 = IsInTriggerBox(State.Trigger2Transform, State.Trigger2Extent, PlayerLocation);
+
+	// A new player or placement starts from its current overlap, without switching.
+	if (Sequence != PhysicsStateSequence)
+	{
+		PhysicsStateSequence = Sequence;
+		bPlayerInTrigger1 = bInTrigger1;
+		bPlayerInTrigger2 = bInTrigger2;
+		return;
+	}
+
+	// Same rules as the end overlap events.
+	if (bPlayerInTrigger1 && !bInTrigger1 && !bInTrigger2)
+		PendingSwitches.Enqueue(1);
+
+	if (bPlayerInTrigger2 && !bInTrigger2 && !bInTrigger1)
+		PendingSwitches.Enqueue(2);
+
+	bPlayerInTrigger1 = bInTrigger1;
+	bPlayerInTrigger2 = bInTrigger2;
+}
+#endif
 #pragma endregion
 
 #pragma region CLASS_EVENTS
@@ -151,16 +237,12 @@ void AFixedCameraTrigger::OnTriggerBeginOverlap2(UPrimitiveComponent* Overlapped
 /// <param name="OtherBodyIndex"></param>
 void AFixedCameraTrigger::OnTriggerEndOverlap1(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
 {
-	if (!Camera1)
-		return;
-
 	if (Trigger2->IsOverlappingComponent(OtherComp))
 	{
 		return;
 	}
 
-	Camera2->DeactivateFixedCamera();
-	Camera1->ActivateFixedCamera(fSmoothTransition1, BlendFunc1, fBlendExp1);
+	SwitchToCamera1();
 }
 
 /// <summary>
@@ -171,16 +253,228 @@ void AFixedCameraTrigger::OnTriggerEndOverlap1(UPrimitiveComponent* OverlappedCo
 /// <param name="OtherComp"></param>
 /// <param name="OtherBodyIndex"></param>
 void AFixedCameraTrigger::OnTriggerEndOverlap2(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	if (Trigger1->IsOverlappingComponent(OtherComp))
+	{
+		return;
+	}
+
+	SwitchToCamera2();
+}
+
+/// <summary>
+/// Deactivates camera 2 and activates camera 1.
+/// </summary>
+void AFixedCameraTrigger::SwitchToCamera1()
+{
+	if (!Camera1)
+		return;
+
+	if (Camera2)
+		Camera2->DeactivateFixedCamera();
+	Camera1->ActivateFixedCamera(fSmoothTransition1, BlendFunc1, fBlendExp1);
+}
+
+/// <summary>
+/// Deactivates camera 1 and activates camera 2.
+/// </summary>
+void AFixedCameraTrigger::SwitchToCamera2()
 {
 	if (!Camera2)
 		return;
 
-	if (Trigger1->IsOverlappingComponent(OtherComp))
+	if (Camera1)
+		Camera1->DeactivateFixedCamera();
+	Camera2->ActivateFixedCamera(fSmoothTransition2, BlendFunc2, fBlendExp2);
+}
+
+/// <summary>
+/// Lays out the trigger boxes for the current scale and restarts their evaluation, so the trigger can be moved and reused.
+/// </summary>
+void AFixedCameraTrigger::ResetTrigger()
+{
+	LayoutTriggers();
+
+	// Switches posted for the previous placement are dropped (the async physics tick must be disabled).
+	PendingSwitches.Empty();
+
+	// The player is looked up again, the previous one may be gone.
+	ReleasePlayer();
+
+	Trigger1->SetGenerateOverlapEvents(true);
+	Trigger2->SetGenerateOverlapEvents(true);
+
+	if (bEvaluateOnAsyncPhysicsTick)
+		StartAsyncPhysicsEvaluation();
+}
+
+/// <summary>
+/// Stops evaluating the player and forgets it, so a released trigger keeps no player state.
+/// </summary>
+void AFixedCameraTrigger::StopTrigger()
+{
+#if FIXEDCAMERA_WITH_ASYNC_PHYSICS_TICK
+	SetAsyncPhysicsTickEnabled(false);
+#endif
+
+	PendingSwitches.Empty();
+	ReleasePlayer();
+}
+
+/// <summary>
+/// Applies the camera switches posted by the physics thread, in order (called every frame by the subsystem).
+/// </summary>
+void AFixedCameraTrigger::ApplyPendingSwitches()
+{
+	uint8 PendingSwitch;
+	while (PendingSwitches.Dequeue(PendingSwitch))
 	{
+		if (PendingSwitch == 1)
+			SwitchToCamera1();
+		else
+			SwitchToCamera2();
+	}
+}
+
+/// <summary>
+/// Places both trigger boxes side by side for the current actor scale.
+/// </summary>
+void AFixedCameraTrigger::LayoutTriggers()
+{
+	SetActorScale3D(FVector(.1f, GetActorScale3D().Y, GetActorScale3D().Z));
+
+	Trigger1->SetRelativeLocation(FVector(-Trigger1->GetCollisionShape().GetExtent().X / GetActorScale3D().X, Trigger1->GetCollisionShape().GetExtent().Y / GetActorScale3D().Y, Trigger1->GetCollisionShape().GetExtent().Z / GetActorScale3D().Z));
+	Trigger2->SetRelativeLocation(FVector(Trigger2->GetCollisionShape().GetExtent().X / GetActorScale3D().X, Trigger1->GetCollisionShape().GetExtent().Y / GetActorScale3D().Y, Trigger2->GetCollisionShape().GetExtent().Z / GetActorScale3D().Z));
+}
+
+/// <summary>
+/// Follows the player pawn, publishes the trigger boxes and its body for the physics thread and starts the async physics tick.
+/// </summary>
+void AFixedCameraTrigger::StartAsyncPhysicsEvaluation()
+{
+#if FIXEDCAMERA_WITH_ASYNC_PHYSICS_TICK
+	APlayerController* Controller = UGameplayStatics::GetPlayerController(this, 0);
+	if (!Controller)
+	{
+		UE_LOG(LogFixedCameraSystem, Warning, TEXT("%s: there is no player controller to follow, overlap events are used instead."), *GetName());
 		return;
 	}
 
-	Camera1->DeactivateFixedCamera();
-	Camera2->ActivateFixedCamera(fSmoothTransition2, BlendFunc2, fBlendExp2);
+	// The body is only looked up again when the possessed pawn changes, never every frame.
+	PlayerController = Controller;
+	Controller->OnPossessedPawnChanged.AddUniqueDynamic(this, &AFixedCameraTrigger::OnPlayerPawnChanged);
+	TrackPlayerPawn(Controller->GetPawn());
+
+	Trigger1->SetGenerateOverlapEvents(false);
+	Trigger2->SetGenerateOverlapEvents(false);
+
+	SetAsyncPhysicsTickEnabled(true);
+#else
+	UE_LOG(LogFixedCameraSystem, Warning, TEXT("%s: async physics tick evaluation requires UE 5.2 or newer, overlap events are used instead."), *GetName());
+#endif
+}
+
+/// <summary>
+/// Follows the body of a player pawn, publishing it for the physics thread.
+/// </summary>
+/// <param name="Pawn">Possessed pawn (null if none).</param>
+void AFixedCameraTrigger::TrackPlayerPawn(APawn* Pawn)
+{
+#if FIXEDCAMERA_WITH_ASYNC_PHYSICS_TICK
+	UPrimitiveComponent* Primitive = Pawn ? Cast<UPrimitiveComponent>(Pawn->GetRootComponent()) : nullptr;
+
+	UPrimitiveComponent* PreviousPrimitive = PlayerPrimitive.Get();
+	if (PreviousPrimitive && PreviousPrimitive != Primitive)
+		PreviousPrimitive->OnComponentPhysicsStateChanged.RemoveDynamic(this, &AFixedCameraTrigger::OnPlayerPhysicsStateChanged);
+
+	PlayerPrimitive = Primitive;
+
+	FBodyInstance* BodyInstance = nullptr;
+	if (Primitive)
+	{
+		Primitive->OnComponentPhysicsStateChanged.AddUniqueDynamic(this, &AFixedCameraTrigger::OnPlayerPhysicsStateChanged);
+		BodyInstance = Primitive->GetBodyInstance();
+	}
+
+	PublishAsyncState(BodyInstance ? BodyInstance->GetPhysicsActorHandle() : nullptr);
+#endif
+}
+
+/// <summary>
+/// Stops following the player controller and the player body.
+/// </summary>
+void AFixedCameraTrigger::ReleasePlayer()
+{
+#if FIXEDCAMERA_WITH_ASYNC_PHYSICS_TICK
+	if (APlayerController* Controller = PlayerController.Get())
+		Controller->OnPossessedPawnChanged.RemoveDynamic(this, &AFixedCameraTrigger::OnPlayerPawnChanged);
+
+	if (UPrimitiveComponent* Primitive = PlayerPrimitive.Get())
+		Primitive->OnComponentPhysicsStateChanged.RemoveDynamic(this, &AFixedCameraTrigger::OnPlayerPhysicsStateChanged);
+#endif
+	PlayerController.Reset();
+	PlayerPrimitive.Reset();
+
+	PublishAsyncState(nullptr);
+}
+
+/// <summary>
+/// Publishes the trigger boxes and the player body for the physics thread, which restarts its evaluation.
+/// </summary>
+/// <param name="PlayerProxy">Player body (null if none).</param>
+void AFixedCameraTrigger::PublishAsyncState(Chaos::FSingleParticlePhysicsProxy* PlayerProxy)
+{
+	// Only the game thread writes, so the sequence is odd exactly while the state is being written.
+	const uint32 Sequence = AsyncStateSequence.load(std::memory_order_relaxed);
+	AsyncStateSequence.store(Sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	// Triggers are static while placed, so the boxes are only published with the placement or the player.
+	AsyncState.Trigger1Transform = Trigger1->GetComponentTransform();
+	AsyncState.Trigger1Extent = Trigger1->GetUnscaledBoxExtent();
+	AsyncState.Trigger2Transform = Trigger2->GetComponentTransform();
+	AsyncState.Trigger2Extent = Trigger2->GetUnscaledBoxExtent();
+	AsyncState.PlayerProxy = PlayerProxy;
+
+	AsyncStateSequence.store(Sequence + 2, std::memory_order_release);
+}
+
+/// <summary>
+/// Called when the player controller possesses another pawn.
+/// </summary>
+/// <param name="OldPawn">Previous pawn.</param>
+/// <param name="NewPawn">Possessed pawn.</param>
+void AFixedCameraTrigger::OnPlayerPawnChanged(APawn* OldPawn, APawn* NewPawn)
+{
+	TrackPlayerPawn(NewPawn);
+}
+
+/// <summary>
+/// Called when the player body is created or destroyed, so the physics thread never reads a destroyed body.
+/// </summary>
+/// <param name="Component">Player root component.</param>
+/// <param name="StateChange">Created or destroyed.</param>
+void AFixedCameraTrigger::OnPlayerPhysicsStateChanged(UPrimitiveComponent* Component, EComponentPhysicsStateChange StateChange)
+{
+#if FIXEDCAMERA_WITH_ASYNC_PHYSICS_TICK
+	// Sent before the body is terminated, so the cleared state is published before the body is removed from the physics scene.
+	FBodyInstance* BodyInstance = StateChange == EComponentPhysicsStateChange::Created && Component ? Component->GetBodyInstance() : nullptr;
+	PublishAsyncState(BodyInstance ? BodyInstance->GetPhysicsActorHandle() : nullptr);
+#endif
+}
+
+/// <summary>
+/// Returns true if the location is inside the cached trigger box.
+/// </summary>
+/// <param name="BoxTransform">Cached box world transform.</param>
+/// <param name="BoxExtent">Cached box extent.</param>
+/// <param name="Location">World location.</param>
+bool AFixedCameraTrigger::IsInTriggerBox(const FTransform& BoxTransform, const FVector& BoxExtent, const FVector& Location)
+{
+	const FVector LocalLocation = BoxTransform.InverseTransformPosition(Location);
+
+	return FMath::Abs(LocalLocation.X) <= BoxExtent.X
+		&& FMath::Abs(LocalLocation.Y) <= BoxExtent.Y
+		&& FMath::Abs(LocalLocation.Z) <= BoxExtent.Z;
 }
 #pragma endregion
\ No newline at end of file
@@ -0,0 +1,16 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+/// <summary>
+/// Four float lane register used by the vectorized camera queries (FVector is double in UE5).
+/// </summary>
+#if ENGINE_MAJOR_VERSION == 5
+typedef VectorRegister4Float FFixedCameraVectorRegister;
+#else
+typedef VectorRegister FFixedCameraVectorRegister;
+#endif
@@ -0,0 +1,186 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "FixedCameraActor.h"
+#include "FixedCameraCoverageMap.generated.h"
+
+UCLASS()
+class FIXEDCAMERASYSTEM_API AFixedCameraCoverageMap : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	/// <summary>
+	/// Root scene component.
+	/// </summary>
+	UPROPERTY(VisibleDefaultsOnly, meta = (Category = "Fixed Camera Coverage Map"))
+	USceneComponent* Root;
+
+	/// <summary>
+	/// Cameras evaluated by the bake. Every fixed camera in the level is used if empty.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Coverage Map Settings", DisplayName = "Candidate Cameras", Tooltip = "Cameras evaluated by the bake. Every fixed camera in the level is used if empty."))
+	TArray<AFixedCameraActor*> CandidateCameras;
+
+	/// <summary>
+	/// Size of each lookup cell.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Coverage Map Settings", DisplayName = "Cell Size", ClampMin = "10.0", Tooltip = "Size of each lookup cell."))
+	float fCellSize = 200.f;
+
+	/// <summary>
+	/// Height above the navmesh used as the traced subject location.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Coverage Map Settings", DisplayName = "Subject Height", ClampMin = "0.0", Tooltip = "Height above the navmesh used as the traced subject location."))
+	float fSubjectHeight = 90.f;
+
+	/// <summary>
+	/// Samples further than this distance from a camera are not covered by it.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Coverage Map Settings", DisplayName = "Max Distance", ClampMin = "0.0", Tooltip = "Samples further than this distance from a camera are not covered by it."))
+	float fMaxDistance = 4000.f;
+
+	/// <summary>
+	/// Desired subject height on screen (0 to 1).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Coverage Map Settings", DisplayName = "Ideal Screen Size", ClampMin = "0.01", ClampMax = "1.0", UIMin = "0.01", UIMax = "1.0", Tooltip = "Desired subject height on screen (0 to 1)."))
+	float fIdealScreenSize = 0.25f;
+
+	/// <summary>
+	/// Weight of the distance score.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Coverage Map Settings", DisplayName = "Distance Weight", ClampMin = "0.0", Tooltip = "Weight of the distance score."))
+	float fDistanceWeight = 1.f;
+
+	/// <summary>
+	/// Weight of the screen size score.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Coverage Map Settings", DisplayName = "Screen Size Weight", ClampMin = "0.0", Tooltip = "Weight of the screen size score."))
+	float fScreenSizeWeight = 1.f;
+
+	/// <summary>
+	/// Smoothness transition quantity.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Coverage Map Settings|Transition", DisplayName = "Smooth Transition", ClampMin = 0.f, Tooltip = "Smoothness transition quantity."))
+	float fSmoothTransition = 0.f;
+
+	/// <summary>
+	/// Smoothness blend type.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Coverage Map Settings|Transition", DisplayName = "Blend Type", EditCondition = "fSmoothTransition != 0", EditConditionHides, Tooltip = "Smoothness blend type."))
+	TEnumAsByte<EViewTargetBlendFunction> BlendFunc = VTBlend_Linear;
+
+	/// <summary>
+	/// Smoothness blend exponent.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Coverage Map Settings|Transition", DisplayName = "Blend Exponent", EditCondition = "fSmoothTransition != 0", EditConditionHides, ClampMin = 0.f, Tooltip = "Smoothness blend exponent."))
+	float fBlendExp = 0.f;
+
+	/// <summary>
+	/// Baked cameras, indexed by the lookup cells.
+	/// </summary>
+	UPROPERTY(VisibleAnywhere, meta = (Category = "Fixed Camera Coverage Map|Baked Data", Tooltip = "Baked cameras, indexed by the lookup cells."))
+	TArray<AFixedCameraActor*> BakedCameras;
+
+	/// <summary>
+	/// Baked camera index per cell (MAX_uint16 when no camera covers the cell).
+	/// </summary>
+	UPROPERTY()
+	TArray<uint16> CellCameras;
+
+	/// <summary>
+	/// World location of the first cell corner.
+	/// </summary>
+	UPROPERTY(VisibleAnywhere, meta = (Category = "Fixed Camera Coverage Map|Baked Data", Tooltip = "World location of the first cell corner."))
+	FVector GridOrigin;
+
+	/// <summary>
+	/// Number of cells along X.
+	/// </summary>
+	UPROPERTY(VisibleAnywhere, meta = (Category = "Fixed Camera Coverage Map|Baked Data", Tooltip = "Number of cells along X."))
+	int32 GridSizeX;
+
+	/// <summary>
+	/// Number of cells along Y.
+	/// </summary>
+	UPROPERTY(VisibleAnywhere, meta = (Category = "Fixed Camera Coverage Map|Baked Data", Tooltip = "Number of cells along Y."))
+	int32 GridSizeY;
+
+	/// <summary>
+	/// Cell size used by the last bake.
+	/// </summary>
+	UPROPERTY()
+	float fBakedCellSize;
+
+private:
+	/// <summary>
+	/// Index of the active baked camera.
+	/// </summary>
+	int32 CurrentCamera;
+
+	/// <summary>
+	/// Player character reference.
+	/// </summary>
+	AActor* PlayerCharacterActorReference;
+
+public:
+	/// <summary>
+	/// Sets default values for this actor's properties.
+	/// </summary>
+	AFixedCameraCoverageMap();
+
+	/// <summary>
+	/// Called every frame.
+	/// </summary>
+	/// <param name="DeltaTime">Time between frames.</param>
+	virtual void Tick(float DeltaTime) override;
+
+	/// <summary>
+	/// Returns the camera covering a world location in O(1).
+	/// </summary>
+	/// <param name="Location">World location.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera Coverage Map", Tooltip = "Returns the camera covering a world location in O(1)."))
+	AFixedCameraActor* GetCameraAtLocation(const FVector& Location) const;
+
+#if WITH_EDITOR
+	/// <summary>
+	/// Samples the walkable navmesh, scores every camera and writes the best one per cell.
+	/// </summary>
+	UFUNCTION(CallInEditor, meta = (Category = "Fixed Camera Coverage Map", DisplayName = "Bake Coverage", Tooltip = "Samples the walkable navmesh, scores every camera and writes the best one per cell."))
+	void BakeCoverage();
+#endif
+
+protected:
+	/// <summary>
+	/// Called when the game starts or when spawned.
+	/// </summary>
+	virtual void BeginPlay() override;
+
+private:
+	/// <summary>
+	/// Returns the baked camera index of a world location.
+	/// </summary>
+	/// <param name="Location">World location.</param>
+	int32 GetCameraIndexAtLocation(const FVector& Location) const;
+
+#if WITH_EDITOR
+	/// <summary>
+	/// Scores the view of a camera over a navmesh sample.
+	/// </summary>
+	/// <param name="Camera">Evaluated camera.</param>
+	/// <param name="SampleLocation">Traced subject location.</param>
+	float ScoreCamera(const AFixedCameraActor* Camera, const FVector& SampleLocation) const;
+
+	/// <summary>
+	/// Returns true if a point is inside a convex polygon, ignoring heights.
+	/// </summary>
+	/// <param name="Verts">Polygon vertices in either winding order.</param>
+	/// <param name="Point">Tested point.</param>
+	static bool IsInsidePolygon2D(const TArray<FVector>& Verts, const FVector2D& Point);
+#endif
+};
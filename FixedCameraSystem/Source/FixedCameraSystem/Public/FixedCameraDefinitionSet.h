@@ -0,0 +1,245 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Camera/CameraTypes.h"
+#include "FixedCameraProfile.h"
+#include "FixedCameraNetwork.h"
+#include "FixedCameraDefinitionSet.generated.h"
+
+class AFixedCameraPath;
+
+/// <summary>
+/// Fixed camera without an actor: a transform, a few settings and optionally a rail.
+/// </summary>
+USTRUCT(BlueprintType)
+struct FIXEDCAMERASYSTEM_API FFixedCameraDefinition
+{
+	GENERATED_BODY()
+
+	/// <summary>
+	/// Unique identifier used to activate the camera.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Definition", DisplayName = "Camera ID", Tooltip = "Unique identifier used to activate the camera."))
+	FName CameraId;
+
+	/// <summary>
+	/// Camera location (the start of the rail is used if a rail is set).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Definition", MakeEditWidget, Tooltip = "Camera location (the start of the rail is used if a rail is set)."))
+	FVector Location = FVector::ZeroVector;
+
+	/// <summary>
+	/// Camera rotation.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Definition", Tooltip = "Camera rotation."))
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	/// <summary>
+	/// Horizontal field of view in degrees, used when no profile is set.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Definition", DisplayName = "Field of View", EditCondition = "Profile == nullptr", ClampMin = "5.0", ClampMax = "170.0", Tooltip = "Horizontal field of view in degrees, used when no profile is set."))
+	float fFieldOfView = 90.f;
+
+	/// <summary>
+	/// Camera focus type, used when no profile is set. Only player focus modes are supported without an actor.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Definition", EditCondition = "Profile == nullptr", Tooltip = "Camera focus type, used when no profile is set. Only player focus modes are supported without an actor."))
+	ECameraFocus CameraFocus = ECameraFocus::NoFocus;
+
+	/// <summary>
+	/// Shared focus, rail and lens settings. Only player focus modes are supported without an actor.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Definition", Tooltip = "Shared focus, rail and lens settings. Only player focus modes are supported without an actor."))
+	UFixedCameraProfile* Profile = nullptr;
+
+	/// <summary>
+	/// Optional rail the camera travels along.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Definition", Tooltip = "Optional rail the camera travels along."))
+	AFixedCameraPath* CameraRail = nullptr;
+
+	/// <summary>
+	/// Rail of the loaded camera network, used when no rail actor is set.
+	/// </summary>
+	UPROPERTY()
+	int32 NetworkRail = INDEX_NONE;
+};
+
+/// <summary>
+/// Many fixed cameras stored as plain definitions in a single actor, which is the view target of all of them.
+/// </summary>
+UCLASS()
+class FIXEDCAMERASYSTEM_API AFixedCameraDefinitionSet : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	/// <summary>
+	/// Root scene component.
+	/// </summary>
+	UPROPERTY(VisibleDefaultsOnly, meta = (Category = "Fixed Camera Definitions"))
+	USceneComponent* Root;
+
+	/// <summary>
+	/// Camera definitions (locations are relative to this actor).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Fixed Camera Definitions", TitleProperty = "CameraId", Tooltip = "Camera definitions (locations are relative to this actor)."))
+	TArray<FFixedCameraDefinition> Definitions;
+
+	/// <summary>
+	/// Definition activated on play.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Definitions", DisplayName = "Activate on Play", Tooltip = "Definition activated on play."))
+	FName DefaultCameraId;
+
+	/// <summary>
+	/// Camera network file loaded on play, relative to the project content directory. It replaces the definitions.
+	/// The file is not a package, so its directory must be in DirectoriesToAlwaysStageAsNonUFS to be packaged.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Definitions", DisplayName = "Network File", Tooltip = "Camera network file loaded on play, relative to the project content directory. It replaces the definitions. The file is not a package, so its directory must be in DirectoriesToAlwaysStageAsNonUFS (Project Settings > Packaging) to be packaged."))
+	FString NetworkFile;
+
+private:
+	/// <summary>
+	/// Loaded camera network (rails and zones are used while this set is the view target).
+	/// </summary>
+	FFixedCameraNetwork Network;
+
+	/// <summary>
+	/// Network zone the player is in.
+	/// </summary>
+	int32 CurrentZone;
+
+	/// <summary>
+	/// Definition index per camera identifier.
+	/// </summary>
+	TMap<FName, int32> DefinitionIndices;
+
+	/// <summary>
+	/// Active definition and its resolved settings.
+	/// </summary>
+	int32 ActiveIndex;
+	FFixedCameraSettings ActiveSettings;
+
+	/// <summary>
+	/// Current view of the active definition.
+	/// </summary>
+	FVector ActiveLocation;
+	FRotator ActiveRotation;
+
+	/// <summary>
+	/// Last computed view, blended out when another definition is activated.
+	/// </summary>
+	FMinimalViewInfo LastView;
+	FMinimalViewInfo BlendFromView;
+
+	/// <summary>
+	/// Blend between two definitions of this set.
+	/// </summary>
+	float fBlendTime;
+	float fBlendDuration;
+	float fBlendExponent;
+	TEnumAsByte<EViewTargetBlendFunction> BlendFunction;
+
+	/// <summary>
+	/// Player character reference.
+	/// </summary>
+	AActor* PlayerCharacterActorReference;
+
+public:
+	/// <summary>
+	/// Sets default values for this actor's properties.
+	/// </summary>
+	AFixedCameraDefinitionSet();
+
+	/// <summary>
+	/// Computes the view of the active definition.
+	/// </summary>
+	/// <param name="DeltaTime">Time between frames.</param>
+	/// <param name="OutResult">View.</param>
+	virtual void CalcCamera(float DeltaTime, FMinimalViewInfo& OutResult) override;
+
+	/// <summary>
+	/// Makes a definition the view.
+	/// </summary>
+	/// <param name="CameraId">Definition identifier.</param>
+	/// <param name="fSmoothTransition">Smoothness quantity.</param>
+	/// <param name="BlendFunc">Smoothness type.</param>
+	/// <param name="fBlendExp">Smoothness blend exponent.</param>
+	/// <returns>False if no definition has this identifier.</returns>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Makes a definition the view."))
+	bool ActivateDefinition(FName CameraId, float fSmoothTransition = 0.f, TEnumAsByte<EViewTargetBlendFunction> BlendFunc = VTBlend_Linear, float fBlendExp = 0.f);
+
+	/// <summary>
+	/// Returns the identifier of the active definition (none if no definition is active).
+	/// </summary>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns the identifier of the active definition (none if no definition is active)."))
+	FName GetActiveCameraId() const;
+
+	/// <summary>
+	/// Returns the definition with this identifier, or null.
+	/// </summary>
+	/// <param name="CameraId">Definition identifier.</param>
+	const FFixedCameraDefinition* FindDefinition(FName CameraId) const;
+
+	/// <summary>
+	/// Replaces the definitions with the cameras of a network file.
+	/// Packaged builds only contain the file if its directory is in DirectoriesToAlwaysStageAsNonUFS.
+	/// </summary>
+	/// <param name="FilePath">Network file, relative to the project content directory.</param>
+	/// <returns>False if the file could not be loaded.</returns>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Replaces the definitions with the cameras of a network file."))
+	bool LoadNetworkFile(const FString& FilePath);
+
+	/// <summary>
+	/// Replaces the definitions with the cameras of a network.
+	/// </summary>
+	/// <param name="InNetwork">Camera network, in the space of this actor.</param>
+	void LoadNetwork(FFixedCameraNetwork&& InNetwork);
+
+protected:
+	/// <summary>
+	/// Called when the game starts or when spawned.
+	/// </summary>
+	virtual void BeginPlay() override;
+
+private:
+	/// <summary>
+	/// Builds the definition index of each camera identifier.
+	/// </summary>
+	void BuildDefinitionIndices();
+
+	/// <summary>
+	/// Makes a definition the view.
+	/// </summary>
+	/// <param name="DefinitionIndex">Definition.</param>
+	/// <param name="fSmoothTransition">Smoothness quantity.</param>
+	/// <param name="BlendFunc">Smoothness type.</param>
+	/// <param name="fBlendExp">Smoothness blend exponent.</param>
+	/// <returns>False if there is no player controller.</returns>
+	bool ActivateDefinitionAt(int32 DefinitionIndex, float fSmoothTransition, TEnumAsByte<EViewTargetBlendFunction> BlendFunc, float fBlendExp);
+
+	/// <summary>
+	/// Activates the camera of the network zone the player enters.
+	/// </summary>
+	void UpdateNetworkZone();
+
+	/// <summary>
+	/// Moves and rotates the active definition towards the player.
+	/// </summary>
+	/// <param name="DeltaTime">Time between frames.</param>
+	void UpdateActiveView(float DeltaTime);
+
+	/// <summary>
+	/// Returns the world transform of a definition.
+	/// </summary>
+	/// <param name="Definition">Camera definition.</param>
+	/// <param name="OutLocation">World location.</param>
+	/// <param name="OutRotation">World rotation.</param>
+	void GetDefinitionTransform(const FFixedCameraDefinition& Definition, FVector& OutLocation, FRotator& OutRotation) const;
+};
@@ -0,0 +1,207 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "WorldCollision.h"
+#include "FixedCameraActor.h"
+#include "FixedCameraDirector.generated.h"
+
+/// <summary>
+/// Snapshot of a candidate camera, scored off the game thread.
+/// </summary>
+struct FFixedCameraDirectorCandidate
+{
+	AFixedCameraActor* Camera;
+	FVector Location;
+	FVector Forward;
+	float fHalfFOV;
+	bool bTracksPlayer;
+	float fVisibility;
+};
+
+UCLASS()
+class FIXEDCAMERASYSTEM_API AFixedCameraDirector : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	/// <summary>
+	/// Root scene component.
+	/// </summary>
+	UPROPERTY(VisibleDefaultsOnly, meta = (Category = "Fixed Camera Director"))
+	USceneComponent* Root;
+
+	/// <summary>
+	/// Cameras the director can cut to. Every fixed camera in the level is used if empty.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Director Settings", DisplayName = "Candidate Cameras", Tooltip = "Cameras the director can cut to. Every fixed camera in the level is used if empty."))
+	TArray<AFixedCameraActor*> CandidateCameras;
+
+	/// <summary>
+	/// Only cameras closer than this distance to the player are evaluated.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Director Settings", DisplayName = "Candidate Radius", ClampMin = "0.0", Tooltip = "Only cameras closer than this distance to the player are evaluated."))
+	float fCandidateRadius = 4000.f;
+
+	/// <summary>
+	/// Seconds between evaluations (0 evaluates every frame).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Director Settings", DisplayName = "Evaluation Interval", ClampMin = "0.0", Tooltip = "Seconds between evaluations (0 evaluates every frame)."))
+	float fEvaluationInterval = 0.1f;
+
+	/// <summary>
+	/// Player height, used for the head visibility trace and the screen size.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Director Settings", DisplayName = "Subject Height", ClampMin = "0.0", Tooltip = "Player height, used for the head visibility trace and the screen size."))
+	float fSubjectHeight = 180.f;
+
+	/// <summary>
+	/// Desired subject height on screen (0 to 1).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Director Settings", DisplayName = "Ideal Screen Size", ClampMin = "0.01", ClampMax = "1.0", UIMin = "0.01", UIMax = "1.0", Tooltip = "Desired subject height on screen (0 to 1)."))
+	float fIdealScreenSize = 0.25f;
+
+	/// <summary>
+	/// Weight of the visibility score.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Director Settings", DisplayName = "Visibility Weight", ClampMin = "0.0", Tooltip = "Weight of the visibility score."))
+	float fVisibilityWeight = 2.f;
+
+	/// <summary>
+	/// Weight of the screen size score.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Director Settings", DisplayName = "Screen Size Weight", ClampMin = "0.0", Tooltip = "Weight of the screen size score."))
+	float fScreenSizeWeight = 1.f;
+
+	/// <summary>
+	/// Weight of the angle score (player facing the camera and centered in the frame).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Director Settings", DisplayName = "Angle Weight", ClampMin = "0.0", Tooltip = "Weight of the angle score (player facing the camera and centered in the frame)."))
+	float fAngleWeight = 1.f;
+
+	/// <summary>
+	/// Score advantage a camera needs over the active one to cut to it.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Director Settings|Hysteresis", DisplayName = "Switch Margin", ClampMin = "0.0", Tooltip = "Score advantage a camera needs over the active one to cut to it."))
+	float fSwitchMargin = 0.3f;
+
+	/// <summary>
+	/// Minimum seconds between cuts (ignored when the active camera loses the player).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Director Settings|Hysteresis", DisplayName = "Min Shot Duration", ClampMin = "0.0", Tooltip = "Minimum seconds between cuts (ignored when the active camera loses the player)."))
+	float fMinShotDuration = 1.5f;
+
+	/// <summary>
+	/// Smoothness transition quantity.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Director Settings|Transition", DisplayName = "Smooth Transition", ClampMin = 0.f, Tooltip = "Smoothness transition quantity."))
+	float fSmoothTransition = 0.f;
+
+	/// <summary>
+	/// Smoothness blend type.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Director Settings|Transition", DisplayName = "Blend Type", EditCondition = "fSmoothTransition != 0", EditConditionHides, Tooltip = "Smoothness blend type."))
+	TEnumAsByte<EViewTargetBlendFunction> BlendFunc = VTBlend_Linear;
+
+	/// <summary>
+	/// Smoothness blend exponent.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Director Settings|Transition", DisplayName = "Blend Exponent", EditCondition = "fSmoothTransition != 0", EditConditionHides, ClampMin = 0.f, Tooltip = "Smoothness blend exponent."))
+	float fBlendExp = 0.f;
+
+private:
+	/// <summary>
+	/// Camera chosen by the director.
+	/// </summary>
+	UPROPERTY()
+	AFixedCameraActor* CurrentCamera;
+
+	/// <summary>
+	/// Seconds since the last cut.
+	/// </summary>
+	float fShotTime;
+
+	/// <summary>
+	/// Seconds since the last evaluation.
+	/// </summary>
+	float fEvaluationTime;
+
+	/// <summary>
+	/// Last consumed visibility (0 to 1) per camera.
+	/// </summary>
+	TMap<TWeakObjectPtr<AFixedCameraActor>, float> CameraVisibility;
+
+	/// <summary>
+	/// Visibility traces issued last frame (player center and head per camera).
+	/// </summary>
+	TArray<TPair<TWeakObjectPtr<AFixedCameraActor>, FTraceHandle>> PendingTraces;
+
+	/// <summary>
+	/// Candidates and scores of the last evaluation (kept to avoid reallocations).
+	/// </summary>
+	TArray<FFixedCameraDirectorCandidate> Candidates;
+	TArray<float> Scores;
+
+	/// <summary>
+	/// Player character reference.
+	/// </summary>
+	AActor* PlayerCharacterActorReference;
+
+public:
+	/// <summary>
+	/// Sets default values for this actor's properties.
+	/// </summary>
+	AFixedCameraDirector();
+
+	/// <summary>
+	/// Called every frame.
+	/// </summary>
+	/// <param name="DeltaTime">Time between frames.</param>
+	virtual void Tick(float DeltaTime) override;
+
+	/// <summary>
+	/// Returns the camera chosen by the director.
+	/// </summary>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera Director", Tooltip = "Returns the camera chosen by the director."))
+	AFixedCameraActor* GetCurrentCamera() const;
+
+protected:
+	/// <summary>
+	/// Called when the game starts or when spawned.
+	/// </summary>
+	virtual void BeginPlay() override;
+
+private:
+	/// <summary>
+	/// Stores the visibility traced last frame.
+	/// </summary>
+	void ConsumeVisibilityTraces();
+
+	/// <summary>
+	/// Gathers the nearby candidates, scores them in parallel and cuts to the best one.
+	/// </summary>
+	void Evaluate();
+
+	/// <summary>
+	/// Issues the visibility traces of the candidates, consumed next frame.
+	/// </summary>
+	void IssueVisibilityTraces();
+
+	/// <summary>
+	/// Scores a candidate view of the player (thread safe).
+	/// </summary>
+	/// <param name="Candidate">Candidate snapshot.</param>
+	/// <param name="PlayerLocation">Player location.</param>
+	/// <param name="PlayerForward">Player facing direction.</param>
+	float ScoreCandidate(const FFixedCameraDirectorCandidate& Candidate, const FVector& PlayerLocation, const FVector& PlayerForward) const;
+
+	/// <summary>
+	/// Deactivates the current camera and activates a new one.
+	/// </summary>
+	/// <param name="NewCamera">Camera to cut to.</param>
+	void SwitchToCamera(AFixedCameraActor* NewCamera);
+};
@@ -0,0 +1,68 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// <summary>
+/// Bounding sphere of a set of actors, reduced four members at a time.
+/// Members are stored in packed arrays, so joining and leaving never rebuild the set.
+/// </summary>
+struct FIXEDCAMERASYSTEM_API FFixedCameraGroupBounds
+{
+public:
+	/// <summary>
+	/// Adds a member. Does nothing if it already belongs to the group.
+	/// </summary>
+	/// <param name="Actor">New member.</param>
+	void Add(AActor* Actor);
+
+	/// <summary>
+	/// Removes a member (swaps the last member into its slot).
+	/// </summary>
+	/// <param name="Actor">Member.</param>
+	void Remove(AActor* Actor);
+
+	/// <summary>
+	/// Removes every member.
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// Returns true if the actor belongs to the group.
+	/// </summary>
+	/// <param name="Actor">Actor.</param>
+	bool Contains(const AActor* Actor) const { return MemberIndices.Contains(Actor); }
+
+	/// <summary>
+	/// Returns the number of members.
+	/// </summary>
+	int32 Num() const { return Members.Num(); }
+
+	/// <summary>
+	/// Gathers the member bounds and returns the sphere containing all of them.
+	/// </summary>
+	/// <param name="OutCenter">Sphere center.</param>
+	/// <param name="OutRadius">Sphere radius.</param>
+	/// <returns>False if the group has no valid member.</returns>
+	bool Compute(FVector& OutCenter, float& OutRadius);
+
+private:
+	/// <summary>
+	/// Members in slot order.
+	/// </summary>
+	TArray<TWeakObjectPtr<AActor>> Members;
+
+	/// <summary>
+	/// Slot of each member.
+	/// </summary>
+	TMap<TWeakObjectPtr<AActor>, int32> MemberIndices;
+
+	/// <summary>
+	/// Member bounds per slot, padded to a multiple of four.
+	/// </summary>
+	TArray<float, TAlignedHeapAllocator<16>> CenterX;
+	TArray<float, TAlignedHeapAllocator<16>> CenterY;
+	TArray<float, TAlignedHeapAllocator<16>> CenterZ;
+	TArray<float, TAlignedHeapAllocator<16>> Radius;
+};
@@ -0,0 +1,140 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "WorldCollision.h"
+#include "FixedCameraOccluderFader.generated.h"
+
+class AFixedCameraActor;
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+class UMeshComponent;
+
+/// <summary>
+/// Free dynamic material instances of one parent material.
+/// </summary>
+USTRUCT()
+struct FFixedCameraMaterialInstancePool
+{
+	GENERATED_BODY()
+
+	/// <summary>
+	/// Instances ready to be reused.
+	/// </summary>
+	UPROPERTY()
+	TArray<UMaterialInstanceDynamic*> FreeInstances;
+};
+
+/// <summary>
+/// Mesh faded by the occluder fader. The materials are referenced so they are not collected while swapped out of the mesh.
+/// </summary>
+USTRUCT()
+struct FFixedCameraFadedMesh
+{
+	GENERATED_BODY()
+
+	/// <summary>
+	/// Materials replaced by pooled instances, per element.
+	/// </summary>
+	UPROPERTY()
+	TArray<UMaterialInterface*> OriginalMaterials;
+
+	/// <summary>
+	/// Pooled instances applied to the mesh, per element (nullptr if the element was not replaced).
+	/// </summary>
+	UPROPERTY()
+	TArray<UMaterialInstanceDynamic*> Instances;
+
+	/// <summary>
+	/// Current opacity.
+	/// </summary>
+	float fOpacity = 1.f;
+
+	/// <summary>
+	/// Was hit by the last consumed sweep.
+	/// </summary>
+	bool bOccluding = false;
+};
+
+/// <summary>
+/// Fades out the meshes between the active fixed camera and the player.
+/// Uses asynchronous sweeps (consumed one frame later) and a pool of dynamic material instances shared by every camera.
+/// </summary>
+UCLASS()
+class FIXEDCAMERASYSTEM_API UFixedCameraOccluderFader : public UObject
+{
+	GENERATED_BODY()
+
+private:
+	/// <summary>
+	/// Free instances keyed by parent material.
+	/// </summary>
+	UPROPERTY()
+	TMap<UMaterialInterface*, FFixedCameraMaterialInstancePool> InstancePools;
+
+	/// <summary>
+	/// Meshes currently faded (or fading back in).
+	/// </summary>
+	UPROPERTY()
+	TMap<TWeakObjectPtr<UMeshComponent>, FFixedCameraFadedMesh> FadedMeshes;
+
+	/// <summary>
+	/// Sweep issued last frame.
+	/// </summary>
+	FTraceHandle SweepHandle;
+
+	/// <summary>
+	/// Fade settings of the last camera that faded occluders.
+	/// </summary>
+	float fFadedOpacity = 0.2f;
+	float fFadeSpeed = 4.f;
+	FName OpacityParameter = TEXT("Opacity");
+
+public:
+	/// <summary>
+	/// Consumes last frame sweep, updates the fades and issues the next sweep.
+	/// </summary>
+	/// <param name="DeltaTime">Time between frames.</param>
+	/// <param name="Camera">Active camera.</param>
+	/// <param name="Target">Actor that must stay visible.</param>
+	void Tick(float DeltaTime, const AFixedCameraActor* Camera, AActor* Target);
+
+	/// <summary>
+	/// Returns true if no mesh is faded.
+	/// </summary>
+	bool IsIdle() const { return FadedMeshes.Num() == 0 && !SweepHandle.IsValid(); }
+
+	/// <summary>
+	/// Restores every faded mesh immediately.
+	/// </summary>
+	void RestoreAll();
+
+private:
+	/// <summary>
+	/// Replaces the materials of a mesh with pooled instances.
+	/// </summary>
+	/// <param name="Mesh">Occluding mesh.</param>
+	/// <param name="OutFadedMesh">Faded mesh state.</param>
+	void BeginFade(UMeshComponent* Mesh, FFixedCameraFadedMesh& OutFadedMesh);
+
+	/// <summary>
+	/// Restores the original materials of a mesh and returns its instances to the pool.
+	/// </summary>
+	/// <param name="Mesh">Faded mesh (may be pending kill).</param>
+	/// <param name="FadedMesh">Faded mesh state.</param>
+	void EndFade(UMeshComponent* Mesh, FFixedCameraFadedMesh& FadedMesh);
+
+	/// <summary>
+	/// Returns a pooled instance of the parent material, creating one if the pool is empty.
+	/// </summary>
+	/// <param name="Parent">Parent material.</param>
+	UMaterialInstanceDynamic* AcquireInstance(UMaterialInterface* Parent);
+
+	/// <summary>
+	/// Returns an instance to its pool.
+	/// </summary>
+	/// <param name="Instance">Dynamic material instance.</param>
+	void ReleaseInstance(UMaterialInstanceDynamic* Instance);
+};
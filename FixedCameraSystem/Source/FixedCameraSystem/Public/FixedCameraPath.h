@@ -46,6 +46,12 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera Path", Tooltip = "Returns Location Along Rail."))
 	FVector GetLocationAlongRail(float TravellingDistance);
 
+	/// <summary>
+	/// Returns the distance along the rail of the closest rail point to a location.
+	/// </summary>
+	/// <param name="Location">World location.</param>
+	float GetDistanceAlongRail(const FVector& Location) const;
+
 	/// <summary>
 	/// Called every frame
 	/// </summary>
@@ -0,0 +1,280 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Camera/PlayerCameraManager.h"
+#include "FixedCameraPool.generated.h"
+
+class AFixedCameraActor;
+class AFixedCameraPath;
+class AFixedCameraTrigger;
+class UFixedCameraProfile;
+
+/// <summary>
+/// Camera of a room description.
+/// </summary>
+USTRUCT(BlueprintType)
+struct FIXEDCAMERASYSTEM_API FFixedCameraRoomCamera
+{
+	GENERATED_BODY()
+
+	/// <summary>
+	/// Unique identifier used by the camera queries.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", DisplayName = "Camera ID", Tooltip = "Unique identifier used by the camera queries."))
+	FName CameraId;
+
+	/// <summary>
+	/// Camera location, relative to the room.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", Tooltip = "Camera location, relative to the room."))
+	FVector Location = FVector::ZeroVector;
+
+	/// <summary>
+	/// Camera rotation, relative to the room.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", Tooltip = "Camera rotation, relative to the room."))
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	/// <summary>
+	/// Shared settings asset (none uses the default camera settings).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", Tooltip = "Shared settings asset (none uses the default camera settings)."))
+	UFixedCameraProfile* Profile = nullptr;
+
+	/// <summary>
+	/// Index of the room rail the camera travels along (-1 for a static camera).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", ClampMin = "-1", Tooltip = "Index of the room rail the camera travels along (-1 for a static camera)."))
+	int32 RailIndex = INDEX_NONE;
+
+	/// <summary>
+	/// Actor tags used by the camera lookup by tag.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", Tooltip = "Actor tags used by the camera lookup by tag."))
+	TArray<FName> Tags;
+};
+
+/// <summary>
+/// Rail of a room description.
+/// </summary>
+USTRUCT(BlueprintType)
+struct FIXEDCAMERASYSTEM_API FFixedCameraRoomRail
+{
+	GENERATED_BODY()
+
+	/// <summary>
+	/// Spline points, relative to the room.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", Tooltip = "Spline points, relative to the room."))
+	TArray<FVector> Points;
+};
+
+/// <summary>
+/// Trigger of a room description. Camera names are swapped like in the trigger actor.
+/// </summary>
+USTRUCT(BlueprintType)
+struct FIXEDCAMERASYSTEM_API FFixedCameraRoomTrigger
+{
+	GENERATED_BODY()
+
+	/// <summary>
+	/// Trigger location, relative to the room.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", Tooltip = "Trigger location, relative to the room."))
+	FVector Location = FVector::ZeroVector;
+
+	/// <summary>
+	/// Trigger rotation, relative to the room.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", Tooltip = "Trigger rotation, relative to the room."))
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	/// <summary>
+	/// Trigger width and height scale.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", Tooltip = "Trigger width and height scale."))
+	FVector2D Scale = FVector2D(5.f, 5.f);
+
+	/// <summary>
+	/// Index of the room camera activated by the orange trigger (-1 for none).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", DisplayName = "Camera 1 (Orange Trigger)", ClampMin = "-1", Tooltip = "Index of the room camera activated by the orange trigger (-1 for none)."))
+	int32 Camera2 = INDEX_NONE;
+
+	/// <summary>
+	/// Smoothness transition quantity 2.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", DisplayName = "Smooth Transition (Camera 1)", ClampMin = "0.0", Tooltip = "Smoothness transition quantity 1."))
+	float fSmoothTransition2 = 0.f;
+
+	/// <summary>
+	/// Smoothness blend type 2.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", DisplayName = "Blend Type (Camera 1)", Tooltip = "Smoothness blend type 1."))
+	TEnumAsByte<EViewTargetBlendFunction> BlendFunc2 = VTBlend_Linear;
+
+	/// <summary>
+	/// Smoothness blend exponent 2.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", DisplayName = "Blend Exponent (Camera 1)", ClampMin = "0.0", Tooltip = "Smoothness blend exponent 1."))
+	float fBlendExp2 = 0.f;
+
+	/// <summary>
+	/// Index of the room camera activated by the blue trigger (-1 for none).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", DisplayName = "Camera 2 (Blue Trigger)", ClampMin = "-1", Tooltip = "Index of the room camera activated by the blue trigger (-1 for none)."))
+	int32 Camera1 = INDEX_NONE;
+
+	/// <summary>
+	/// Smoothness transition quantity 1.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", DisplayName = "Smooth Transition (Camera 2)", ClampMin = "0.0", Tooltip = "Smoothness transition quantity 2."))
+	float fSmoothTransition1 = 0.f;
+
+	/// <summary>
+	/// Smoothness blend type 1.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", DisplayName = "Blend Type (Camera 2)", Tooltip = "Smoothness blend type 2."))
+	TEnumAsByte<EViewTargetBlendFunction> BlendFunc1 = VTBlend_Linear;
+
+	/// <summary>
+	/// Smoothness blend exponent 1.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", DisplayName = "Blend Exponent (Camera 2)", ClampMin = "0.0", Tooltip = "Smoothness blend exponent 2."))
+	float fBlendExp1 = 0.f;
+
+	/// <summary>
+	/// Evaluates the triggers at the fixed physics step instead of using overlap events (requires async physics, UE 5.2+).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", DisplayName = "Evaluate on Async Physics Tick", Tooltip = "Evaluates the triggers at the fixed physics step instead of using overlap events (requires async physics, UE 5.2+)."))
+	bool bEvaluateOnAsyncPhysicsTick = false;
+};
+
+/// <summary>
+/// Cameras, rails and triggers of a room. Cross references are indices into the arrays of the room.
+/// </summary>
+USTRUCT(BlueprintType)
+struct FIXEDCAMERASYSTEM_API FFixedCameraRoomDescription
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room", TitleProperty = "CameraId"))
+	TArray<FFixedCameraRoomCamera> Cameras;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room"))
+	TArray<FFixedCameraRoomRail> Rails;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Room"))
+	TArray<FFixedCameraRoomTrigger> Triggers;
+};
+
+/// <summary>
+/// Actors placed for a spawned room.
+/// </summary>
+USTRUCT()
+struct FFixedCameraPooledRoom
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AFixedCameraActor*> Cameras;
+
+	UPROPERTY()
+	TArray<AFixedCameraPath*> Rails;
+
+	UPROPERTY()
+	TArray<AFixedCameraTrigger*> Triggers;
+};
+
+/// <summary>
+/// Spawns the cameras, rails and triggers of procedural rooms, recycling the actors of released rooms.
+/// </summary>
+UCLASS()
+class FIXEDCAMERASYSTEM_API UFixedCameraPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	/// <summary>
+	/// Released actors, ready to be placed again.
+	/// </summary>
+	UPROPERTY()
+	TArray<AFixedCameraActor*> FreeCameras;
+
+	UPROPERTY()
+	TArray<AFixedCameraPath*> FreeRails;
+
+	UPROPERTY()
+	TArray<AFixedCameraTrigger*> FreeTriggers;
+
+	/// <summary>
+	/// Spawned rooms by identifier.
+	/// </summary>
+	UPROPERTY()
+	TMap<int32, FFixedCameraPooledRoom> Rooms;
+
+	/// <summary>
+	/// Identifier of the next spawned room.
+	/// </summary>
+	int32 NextRoomId = 1;
+
+public:
+	/// <summary>
+	/// Places the cameras, rails and triggers of a room, recycling released actors first.
+	/// Every camera is registered before the triggers are enabled.
+	/// </summary>
+	/// <param name="Room">Room description.</param>
+	/// <param name="RoomTransform">Room world transform.</param>
+	/// <returns>Room identifier (0 if the room is not valid).</returns>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Places the cameras, rails and triggers of a room, recycling released actors first."))
+	int32 SpawnRoom(const FFixedCameraRoomDescription& Room, const FTransform& RoomTransform);
+
+	/// <summary>
+	/// Unregisters and disables the actors of a room and returns them to the pool.
+	/// A room whose camera is the active camera or the view target is kept, the view must move to another camera first.
+	/// </summary>
+	/// <param name="RoomId">Room identifier.</param>
+	/// <returns>False if the room does not exist or one of its cameras is in view.</returns>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Unregisters and disables the actors of a room and returns them to the pool. A room whose camera is the active camera or the view target is kept, the view must move to another camera first."))
+	bool ReleaseRoom(int32 RoomId);
+
+	/// <summary>
+	/// Returns the cameras of a room, in the order of its description.
+	/// </summary>
+	/// <param name="RoomId">Room identifier.</param>
+	/// <param name="OutCameras">Room cameras.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Returns the cameras of a room, in the order of its description."))
+	void GetRoomCameras(int32 RoomId, TArray<AFixedCameraActor*>& OutCameras) const;
+
+	/// <summary>
+	/// Spawns pooled actors ahead of time, so rooms can be placed without spawning.
+	/// </summary>
+	/// <param name="NumCameras">Cameras to add to the pool.</param>
+	/// <param name="NumRails">Rails to add to the pool.</param>
+	/// <param name="NumTriggers">Triggers to add to the pool.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera System", Tooltip = "Spawns pooled actors ahead of time, so rooms can be placed without spawning."))
+	void Prewarm(int32 NumCameras, int32 NumRails, int32 NumTriggers);
+
+private:
+	/// <summary>
+	/// Returns a released actor, or null if the pool is empty.
+	/// </summary>
+	/// <param name="FreeActors">Released actors of a class.</param>
+	template<typename ActorType>
+	static ActorType* PopFree(TArray<ActorType*>& FreeActors);
+
+	/// <summary>
+	/// Unregisters and disables a camera.
+	/// </summary>
+	/// <param name="Camera">Fixed camera.</param>
+	void ReleaseCamera(AFixedCameraActor* Camera);
+
+	/// <summary>
+	/// Unregisters and disables a trigger.
+	/// </summary>
+	/// <param name="Trigger">Fixed camera trigger.</param>
+	void ReleaseTrigger(AFixedCameraTrigger* Trigger);
+};
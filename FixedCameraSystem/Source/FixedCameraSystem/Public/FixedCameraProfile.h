@@ -0,0 +1,301 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "FixedCameraProfile.generated.h"
+
+UENUM()
+enum class ECameraFocus
+{
+	NoFocus        UMETA(DisplayName = "No Focus"),
+	FocusOnPlayer  UMETA(DisplayName = "Focus on Player"),
+	FocusOnObject  UMETA(DisplayName = "Focus on Target"),
+	MiddleLocationPlayerAndInitialFocus  UMETA(DisplayName = "Middle location (Player and Initial Focus)"),
+	MiddleLocationPlayerAndObject		 UMETA(DisplayName = "Middle location (Player and Target)"),
+	FocusOnGroup   UMETA(DisplayName = "Focus on Group"),
+};
+
+UENUM()
+enum class ECameraType
+{
+	Static  UMETA(DisplayName = "Static Camera"),
+	Rail    UMETA(DisplayName = "On Rail Camera")
+};
+
+/// <summary>
+/// Resolved movement and focus settings of a camera, read every frame.
+/// </summary>
+struct FIXEDCAMERASYSTEM_API FFixedCameraSettings
+{
+	FVector2D DeadZone = FVector2D(0.2f, 0.15f);
+	FVector2D SoftZone = FVector2D(0.6f, 0.5f);
+	float fRailTravellingDistance = 2000.f;
+	float fSmoothMovementSpeed = 3.f;
+	float fMiddlePointAlpha = 0.25f;
+	float fSmoothRotationSpeed = 3.f;
+	float fGroupFramingPadding = 1.2f;
+	float fMinGroupFieldOfView = 30.f;
+	float fFieldOfView = 90.f;
+	ECameraFocus CameraFocus = ECameraFocus::NoFocus;
+	uint8 bSmoothMovement : 1;
+	uint8 bSmoothRotation : 1;
+	uint8 bUseDeadZone : 1;
+	uint8 bIncludePlayerInGroup : 1;
+	uint8 bFitGroupInView : 1;
+
+	FFixedCameraSettings()
+		: bSmoothMovement(true)
+		, bSmoothRotation(true)
+		, bUseDeadZone(false)
+		, bIncludePlayerInGroup(true)
+		, bFitGroupInView(false)
+	{
+	}
+};
+
+/// <summary>
+/// Settings of a camera that replace the ones of its profile, or the default ones if it has none.
+/// </summary>
+USTRUCT(BlueprintType)
+struct FIXEDCAMERASYSTEM_API FFixedCameraProfileOverrides
+{
+	GENERATED_BODY()
+
+	// Override toggles, shown as checkboxes next to their values.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (InlineEditConditionToggle))
+	uint8 bOverride_fRailTravellingDistance : 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (InlineEditConditionToggle))
+	uint8 bOverride_bSmoothMovement : 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (InlineEditConditionToggle))
+	uint8 bOverride_fSmoothMovementSpeed : 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (InlineEditConditionToggle))
+	uint8 bOverride_CameraFocus : 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (InlineEditConditionToggle))
+	uint8 bOverride_fMiddlePointAlpha : 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (InlineEditConditionToggle))
+	uint8 bOverride_bSmoothRotation : 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (InlineEditConditionToggle))
+	uint8 bOverride_fSmoothRotationSpeed : 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (InlineEditConditionToggle))
+	uint8 bOverride_bIncludePlayerInGroup : 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (InlineEditConditionToggle))
+	uint8 bOverride_bFitGroupInView : 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (InlineEditConditionToggle))
+	uint8 bOverride_fGroupFramingPadding : 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (InlineEditConditionToggle))
+	uint8 bOverride_fMinGroupFieldOfView : 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (InlineEditConditionToggle))
+	uint8 bOverride_bUseDeadZone : 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (InlineEditConditionToggle))
+	uint8 bOverride_DeadZone : 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (InlineEditConditionToggle))
+	uint8 bOverride_SoftZone : 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (InlineEditConditionToggle))
+	uint8 bOverride_fFieldOfView : 1;
+
+	/// <summary>
+	/// Distance to reach the last point of the rail.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Rail", DisplayName = "Rail Travelling Distance", EditCondition = "bOverride_fRailTravellingDistance", Tooltip = "Distance to reach the last point of the rail."))
+	float fRailTravellingDistance = 2000.f;
+
+	/// <summary>
+	/// Determines if smooth movement will be used.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Rail", DisplayName = "Smooth Movement", EditCondition = "bOverride_bSmoothMovement", Tooltip = "Determines if smooth movement will be used."))
+	bool bSmoothMovement = true;
+
+	/// <summary>
+	/// Smoothness movement velocity.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Rail", DisplayName = "Smooth Movement Speed", ClampMin = "0.0", EditCondition = "bOverride_fSmoothMovementSpeed", Tooltip = "Smoothness movement velocity."))
+	float fSmoothMovementSpeed = 3.f;
+
+	/// <summary>
+	/// Camera focus type.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Focus Parameters", DisplayName = "Camera Focus", EditCondition = "bOverride_CameraFocus", Tooltip = "Camera focus type."))
+	ECameraFocus CameraFocus = ECameraFocus::NoFocus;
+
+	/// <summary>
+	/// Middle point alpha (0 to 1).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Focus Parameters", DisplayName = "Middle Point Alpha", ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0", EditCondition = "bOverride_fMiddlePointAlpha", Tooltip = "Middle point alpha (0 to 1)."))
+	float fMiddlePointAlpha = 0.25f;
+
+	/// <summary>
+	/// Determines if smooth rotation will be used.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Focus Parameters", DisplayName = "Smooth Rotation", EditCondition = "bOverride_bSmoothRotation", Tooltip = "Determines if smooth rotation will be used."))
+	bool bSmoothRotation = true;
+
+	/// <summary>
+	/// Smoothness rotation velocity.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Focus Parameters", DisplayName = "Smooth Rotation Speed", ClampMin = "0.0", EditCondition = "bOverride_fSmoothRotationSpeed", Tooltip = "Smoothness rotation velocity."))
+	float fSmoothRotationSpeed = 3.f;
+
+	/// <summary>
+	/// Adds the player to the framed group.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Focus Parameters", DisplayName = "Include Player in Group", EditCondition = "bOverride_bIncludePlayerInGroup", Tooltip = "Adds the player to the framed group."))
+	bool bIncludePlayerInGroup = true;
+
+	/// <summary>
+	/// Changes the field of view so the whole group fits in the frame.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Focus Parameters", DisplayName = "Fit Group in View", EditCondition = "bOverride_bFitGroupInView", Tooltip = "Changes the field of view so the whole group fits in the frame."))
+	bool bFitGroupInView = false;
+
+	/// <summary>
+	/// Frame margin around the group (1 = tight).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Focus Parameters", DisplayName = "Group Framing Padding", ClampMin = "1.0", EditCondition = "bOverride_fGroupFramingPadding", Tooltip = "Frame margin around the group (1 = tight)."))
+	float fGroupFramingPadding = 1.2f;
+
+	/// <summary>
+	/// Narrowest field of view used to frame the group.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Focus Parameters", DisplayName = "Min Group Field of View", ClampMin = "1.0", ClampMax = "170.0", EditCondition = "bOverride_fMinGroupFieldOfView", Tooltip = "Narrowest field of view used to frame the group."))
+	float fMinGroupFieldOfView = 30.f;
+
+	/// <summary>
+	/// Only rotates the camera when the focus point leaves a screen-space dead zone.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Focus Parameters", DisplayName = "Use Dead Zone", EditCondition = "bOverride_bUseDeadZone", Tooltip = "Only rotates the camera when the focus point leaves a screen-space dead zone."))
+	bool bUseDeadZone = false;
+
+	/// <summary>
+	/// Half size of the dead zone in normalized screen units (0 = center, 1 = screen edge).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Focus Parameters", DisplayName = "Dead Zone", ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bOverride_DeadZone", Tooltip = "Half size of the dead zone in normalized screen units (0 = center, 1 = screen edge)."))
+	FVector2D DeadZone = FVector2D(0.2f, 0.15f);
+
+	/// <summary>
+	/// Half size of the soft zone. Between the dead and soft zones the camera catches up smoothly, beyond it at once.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Focus Parameters", DisplayName = "Soft Zone", ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bOverride_SoftZone", Tooltip = "Half size of the soft zone. Between the dead and soft zones the camera catches up smoothly, beyond it at once."))
+	FVector2D SoftZone = FVector2D(0.6f, 0.5f);
+
+	/// <summary>
+	/// Horizontal field of view in degrees.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Lens", DisplayName = "Field of View", ClampMin = "5.0", ClampMax = "170.0", EditCondition = "bOverride_fFieldOfView", Tooltip = "Horizontal field of view in degrees."))
+	float fFieldOfView = 90.f;
+
+	FFixedCameraProfileOverrides();
+
+	/// <summary>
+	/// Writes the overridden values into the resolved settings.
+	/// </summary>
+	/// <param name="Settings">Settings to fill.</param>
+	void ApplyTo(FFixedCameraSettings& Settings) const;
+};
+
+/// <summary>
+/// Movement and focus settings shared by many fixed cameras.
+/// </summary>
+UCLASS(BlueprintType)
+class FIXEDCAMERASYSTEM_API UFixedCameraProfile : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/// <summary>
+	/// Distance to reach the last point of the rail.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Rail", DisplayName = "Rail Travelling Distance", Tooltip = "Distance to reach the last point of the rail."))
+	float fRailTravellingDistance = 2000.f;
+
+	/// <summary>
+	/// Determines if smooth movement will be used.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Rail", DisplayName = "Smooth Movement", Tooltip = "Determines if smooth movement will be used."))
+	bool bSmoothMovement = true;
+
+	/// <summary>
+	/// Smoothness movement velocity.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Rail", DisplayName = "Smooth Movement Speed", EditCondition = "bSmoothMovement", EditConditionHides, ClampMin = "0.0", Tooltip = "Smoothness movement velocity."))
+	float fSmoothMovementSpeed = 3.f;
+
+	/// <summary>
+	/// Camera focus type.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Focus Parameters", Tooltip = "Camera focus type."))
+	ECameraFocus CameraFocus = ECameraFocus::NoFocus;
+
+	/// <summary>
+	/// Middle point alpha (0 to 1).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Focus Parameters", DisplayName = "Middle Point Alpha", EditCondition = "CameraFocus == ECameraFocus::MiddleLocationPlayerAndObject || CameraFocus == ECameraFocus::MiddleLocationPlayerAndInitialFocus", EditConditionHides, ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0", Tooltip = "Middle point alpha (0 to 1)."))
+	float fMiddlePointAlpha = 0.25f;
+
+	/// <summary>
+	/// Determines if smooth rotation will be used.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Focus Parameters", DisplayName = "Smooth Rotation", EditCondition = "CameraFocus != ECameraFocus::NoFocus", EditConditionHides, Tooltip = "Determines if smooth rotation will be used."))
+	bool bSmoothRotation = true;
+
+	/// <summary>
+	/// Smoothness rotation velocity.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Focus Parameters", DisplayName = "Smooth Rotation Speed", EditCondition = "bSmoothRotation && CameraFocus != ECameraFocus::NoFocus", EditConditionHides, ClampMin = "0.0", Tooltip = "Smoothness rotation velocity."))
+	float fSmoothRotationSpeed = 3.f;
+
+	/// <summary>
+	/// Adds the player to the framed group.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Focus Parameters", DisplayName = "Include Player in Group", EditCondition = "CameraFocus == ECameraFocus::FocusOnGroup", EditConditionHides, Tooltip = "Adds the player to the framed group."))
+	bool bIncludePlayerInGroup = true;
+
+	/// <summary>
+	/// Changes the field of view so the whole group fits in the frame.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Focus Parameters", DisplayName = "Fit Group in View", EditCondition = "CameraFocus == ECameraFocus::FocusOnGroup", EditConditionHides, Tooltip = "Changes the field of view so the whole group fits in the frame."))
+	bool bFitGroupInView = false;
+
+	/// <summary>
+	/// Frame margin around the group (1 = tight).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Focus Parameters", DisplayName = "Group Framing Padding", EditCondition = "CameraFocus == ECameraFocus::FocusOnGroup && bFitGroupInView", EditConditionHides, ClampMin = "1.0", Tooltip = "Frame margin around the group (1 = tight)."))
+	float fGroupFramingPadding = 1.2f;
+
+	/// <summary>
+	/// Narrowest field of view used to frame the group.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Focus Parameters", DisplayName = "Min Group Field of View", EditCondition = "CameraFocus == ECameraFocus::FocusOnGroup && bFitGroupInView", EditConditionHides, ClampMin = "1.0", ClampMax = "170.0", Tooltip = "Narrowest field of view used to frame the group."))
+	float fMinGroupFieldOfView = 30.f;
+
+	/// <summary>
+	/// Only rotates the camera when the focus point leaves a screen-space dead zone.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Focus Parameters", DisplayName = "Use Dead Zone", EditCondition = "CameraFocus != ECameraFocus::NoFocus", EditConditionHides, Tooltip = "Only rotates the camera when the focus point leaves a screen-space dead zone."))
+	bool bUseDeadZone = false;
+
+	/// <summary>
+	/// Half size of the dead zone in normalized screen units (0 = center, 1 = screen edge).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Focus Parameters", DisplayName = "Dead Zone", EditCondition = "CameraFocus != ECameraFocus::NoFocus && bUseDeadZone", EditConditionHides, ClampMin = "0.0", ClampMax = "1.0", Tooltip = "Half size of the dead zone in normalized screen units (0 = center, 1 = screen edge)."))
+	FVector2D DeadZone = FVector2D(0.2f, 0.15f);
+
+	/// <summary>
+	/// Half size of the soft zone. Between the dead and soft zones the camera catches up smoothly, beyond it at once.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Focus Parameters", DisplayName = "Soft Zone", EditCondition = "CameraFocus != ECameraFocus::NoFocus && bUseDeadZone", EditConditionHides, ClampMin = "0.0", ClampMax = "1.0", Tooltip = "Half size of the soft zone. Between the dead and soft zones the camera catches up smoothly, beyond it at once."))
+	FVector2D SoftZone = FVector2D(0.6f, 0.5f);
+
+	/// <summary>
+	/// Horizontal field of view in degrees.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Category = "Lens", DisplayName = "Field of View", ClampMin = "5.0", ClampMax = "170.0", Tooltip = "Horizontal field of view in degrees."))
+	float fFieldOfView = 90.f;
+
+	/// <summary>
+	/// Writes the profile values into the resolved settings.
+	/// </summary>
+	/// <param name="Settings">Settings to fill.</param>
+	void GetSettings(FFixedCameraSettings& Settings) const;
+};
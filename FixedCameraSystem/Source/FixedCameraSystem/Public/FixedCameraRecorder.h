@@ -0,0 +1,181 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FixedCameraRecorder.generated.h"
+
+/// <summary>
+/// Camera switch found in a recording.
+/// </summary>
+USTRUCT(BlueprintType)
+struct FIXEDCAMERASYSTEM_API FFixedCameraRecordedSwitch
+{
+	GENERATED_BODY()
+
+	/// <summary>
+	/// World time of the switch.
+	/// </summary>
+	UPROPERTY(BlueprintReadOnly, meta = (Category = "Fixed Camera Recording", DisplayName = "Time", Tooltip = "World time of the switch."))
+	float fTime = 0.f;
+
+	/// <summary>
+	/// Identifier of the previous camera (none if it was not a fixed camera).
+	/// </summary>
+	UPROPERTY(BlueprintReadOnly, meta = (Category = "Fixed Camera Recording", DisplayName = "Previous Camera ID", Tooltip = "Identifier of the previous camera (none if it was not a fixed camera)."))
+	FName PreviousCameraId;
+
+	/// <summary>
+	/// Identifier of the next camera (none if it is not a fixed camera).
+	/// </summary>
+	UPROPERTY(BlueprintReadOnly, meta = (Category = "Fixed Camera Recording", DisplayName = "Next Camera ID", Tooltip = "Identifier of the next camera (none if it is not a fixed camera)."))
+	FName NextCameraId;
+};
+
+/// <summary>
+/// Quantized recorded view: millimeters, compressed rotation axes and hundredths of a degree.
+/// </summary>
+struct FFixedCameraRecordedFrame
+{
+	/// <summary>
+	/// Milliseconds since the start of the chunk.
+	/// </summary>
+	int32 TimeMs = 0;
+
+	int32 Location[3] = { 0, 0, 0 };
+	uint16 Rotation[3] = { 0, 0, 0 };
+	uint16 FieldOfView = 0;
+	int32 CameraIndex = 0;
+};
+
+/// <summary>
+/// Keyframe followed by the delta frames recorded after it.
+/// </summary>
+struct FFixedCameraRecordedChunk
+{
+	float fStartTime = 0.f;
+	float fEndTime = 0.f;
+	TArray<uint8> Bytes;
+};
+
+/// <summary>
+/// Records the final camera view into a ring of chunks with a fixed memory budget.
+/// Each chunk starts with a keyframe, and the following frames only store the changed values as variable length deltas.
+/// Any time can be sampled by decoding a single chunk.
+/// </summary>
+class FIXEDCAMERASYSTEM_API FFixedCameraRecorder
+{
+public:
+	/// <summary>
+	/// Clears the recording and starts a new one.
+	/// </summary>
+	/// <param name="fMaxDuration">Seconds kept, older chunks are overwritten.</param>
+	/// <param name="fSampleRate">Recorded frames per second (camera switches are always recorded).</param>
+	/// <param name="fInKeyframeInterval">Seconds between keyframes.</param>
+	void Start(float fMaxDuration, float fSampleRate, float fInKeyframeInterval);
+
+	/// <summary>
+	/// Stops recording, keeping the recorded frames.
+	/// </summary>
+	void Stop();
+
+	/// <summary>
+	/// Removes every recorded frame.
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// Returns true while recording.
+	/// </summary>
+	bool IsRecording() const { return bRecording; }
+
+	/// <summary>
+	/// Records a camera view.
+	/// </summary>
+	/// <param name="fTime">World time.</param>
+	/// <param name="Location">View location.</param>
+	/// <param name="Rotation">View rotation.</param>
+	/// <param name="fFieldOfView">View field of view.</param>
+	/// <param name="CameraId">Active fixed camera identifier.</param>
+	void Record(float fTime, const FVector& Location, const FRotator& Rotation, float fFieldOfView, FName CameraId);
+
+	/// <summary>
+	/// Returns the time of the first and last recorded frames.
+	/// </summary>
+	/// <returns>False if nothing is recorded.</returns>
+	bool GetTimeRange(float& OutStartTime, float& OutEndTime) const;
+
+	/// <summary>
+	/// Returns the recorded view at a time. Views are interpolated between frames, except across camera switches.
+	/// </summary>
+	/// <param name="fTime">World time (clamped to the recorded range).</param>
+	/// <returns>False if nothing is recorded.</returns>
+	bool Sample(float fTime, FVector& OutLocation, FRotator& OutRotation, float& OutFieldOfView, FName& OutCameraId) const;
+
+	/// <summary>
+	/// Returns the camera switches recorded in a time range.
+	/// </summary>
+	/// <param name="fStartTime">Range start.</param>
+	/// <param name="fEndTime">Range end.</param>
+	/// <param name="OutSwitches">Camera switches, in time order.</param>
+	void GetSwitches(float fStartTime, float fEndTime, TArray<FFixedCameraRecordedSwitch>& OutSwitches) const;
+
+	/// <summary>
+	/// Returns the bytes used by the recorded frames.
+	/// </summary>
+	int32 GetRecordedSize() const;
+
+private:
+	/// <summary>
+	/// Chunk ring: NumChunks chunks in time order starting at FirstChunk.
+	/// </summary>
+	TArray<FFixedCameraRecordedChunk> Chunks;
+	int32 FirstChunk = 0;
+	int32 NumChunks = 0;
+
+	/// <summary>
+	/// Recorded camera identifiers, referenced by index.
+	/// </summary>
+	TArray<FName> CameraIds;
+	TMap<FName, int32> CameraIndices;
+
+	/// <summary>
+	/// Last recorded frame, the base of the next delta.
+	/// </summary>
+	FFixedCameraRecordedFrame LastFrame;
+	float fLastTime = 0.f;
+
+	float fSampleInterval = 0.f;
+	float fKeyframeInterval = 0.5f;
+	bool bRecording = false;
+
+	/// <summary>
+	/// Returns a chunk by its position in time order.
+	/// </summary>
+	const FFixedCameraRecordedChunk& GetChunk(int32 ChunkIndex) const { return Chunks[(FirstChunk + ChunkIndex) % Chunks.Num()]; }
+
+	/// <summary>
+	/// Returns the position of the last chunk starting at or before a time (0 if the time is before every chunk).
+	/// </summary>
+	int32 FindChunk(float fTime) const;
+
+	/// <summary>
+	/// Appends a frame to a chunk, as a keyframe if it is the first one.
+	/// </summary>
+	/// <param name="Chunk">Chunk.</param>
+	/// <param name="Frame">Quantized frame.</param>
+	/// <param name="bSwitch">The camera changed since the last frame.</param>
+	void WriteFrame(FFixedCameraRecordedChunk& Chunk, const FFixedCameraRecordedFrame& Frame, bool bSwitch);
+
+	/// <summary>
+	/// Decodes the frames of a chunk in order until the visitor returns false.
+	/// </summary>
+	/// <param name="Chunk">Chunk.</param>
+	/// <param name="Visitor">Called with each frame and whether the camera switched on it.</param>
+	static void DecodeChunk(const FFixedCameraRecordedChunk& Chunk, TFunctionRef<bool(const FFixedCameraRecordedFrame&, bool)> Visitor);
+
+	/// <summary>
+	/// Returns the world time of a decoded frame.
+	/// </summary>
+	static float GetFrameTime(const FFixedCameraRecordedChunk& Chunk, const FFixedCameraRecordedFrame& Frame) { return Chunk.fStartTime + Frame.TimeMs * 0.001f; }
+};
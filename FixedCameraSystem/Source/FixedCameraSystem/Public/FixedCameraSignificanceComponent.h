@@ -0,0 +1,102 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "FixedCameraSignificanceComponent.generated.h"
+
+class USkeletalMeshComponent;
+
+UENUM(BlueprintType)
+enum class EFixedCameraSignificance : uint8
+{
+	Insignificant  UMETA(DisplayName = "Insignificant"),
+	Upcoming       UMETA(DisplayName = "Upcoming (Adjacent Camera)"),
+	Visible        UMETA(DisplayName = "Visible (Active Camera)")
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFixedCameraSignificanceChanged, EFixedCameraSignificance, Significance);
+
+UCLASS(ClassGroup = (FixedCamera), meta = (BlueprintSpawnableComponent))
+class FIXEDCAMERASYSTEM_API UFixedCameraSignificanceComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	/// <summary>
+	/// Actor and component tick interval while insignificant.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Significance", DisplayName = "Insignificant Tick Interval", ClampMin = "0.0", Tooltip = "Actor and component tick interval while insignificant."))
+	float fInsignificantTickInterval = 0.5f;
+
+	/// <summary>
+	/// Enables animation update rate optimizations on the skeletal meshes while insignificant.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Significance", DisplayName = "Update Rate Optimizations", Tooltip = "Enables animation update rate optimizations on the skeletal meshes while insignificant."))
+	bool bUseUpdateRateOptimizations = true;
+
+	/// <summary>
+	/// Suspends cloth simulation while insignificant.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Significance", DisplayName = "Suspend Cloth", Tooltip = "Suspends cloth simulation while insignificant."))
+	bool bSuspendCloth = true;
+
+	/// <summary>
+	/// Called when the significance changes.
+	/// </summary>
+	UPROPERTY(BlueprintAssignable, meta = (Category = "Fixed Camera Significance", Tooltip = "Called when the significance changes."))
+	FOnFixedCameraSignificanceChanged OnSignificanceChanged;
+
+private:
+	/// <summary>
+	/// Current significance.
+	/// </summary>
+	EFixedCameraSignificance Significance;
+
+	/// <summary>
+	/// Tick intervals before the first reduction, restored when significant.
+	/// </summary>
+	TMap<TWeakObjectPtr<UActorComponent>, float> OriginalComponentTickIntervals;
+	float fOriginalActorTickInterval;
+
+	/// <summary>
+	/// Update rate optimization flags before the first reduction.
+	/// </summary>
+	TMap<TWeakObjectPtr<UActorComponent>, bool> OriginalUpdateRateOptimizations;
+
+	/// <summary>
+	/// Skeletal meshes whose cloth was suspended by this component (cloth paused by other code is left alone).
+	/// </summary>
+	TArray<TWeakObjectPtr<USkeletalMeshComponent>> SuspendedClothMeshes;
+
+public:
+	/// <summary>
+	/// Sets default values for this component's properties.
+	/// </summary>
+	UFixedCameraSignificanceComponent();
+
+	/// <summary>
+	/// Returns the current significance.
+	/// </summary>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera Significance", Tooltip = "Returns the current significance."))
+	EFixedCameraSignificance GetSignificance() const;
+
+	/// <summary>
+	/// Applies a new significance to the owner (called by the fixed camera subsystem).
+	/// </summary>
+	/// <param name="NewSignificance">New significance.</param>
+	void SetSignificance(EFixedCameraSignificance NewSignificance);
+
+protected:
+	/// <summary>
+	/// Called when the game starts.
+	/// </summary>
+	virtual void BeginPlay() override;
+
+	/// <summary>
+	/// Called when the component is removed from play.
+	/// </summary>
+	/// <param name="EndPlayReason">End play reason.</param>
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+};
@@ -10,8 +10,37 @@
 #include "FixedCameraActor.h"
 #include "Camera/PlayerCameraManager.h"
 #include "Components/BillboardComponent.h"
+#include "Containers/Queue.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include <atomic>
 #include "FixedCameraTrigger.generated.h"
 
+/// <summary>
+/// Actors get an async physics tick from UE 5.2.
+/// </summary>
+#define FIXEDCAMERA_WITH_ASYNC_PHYSICS_TICK (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 2)
+
+namespace Chaos
+{
+	class FSingleParticlePhysicsProxy;
+}
+
+/// <summary>
+/// Trigger boxes and player body published by the game thread for the async physics tick.
+/// </summary>
+struct FFixedCameraTriggerAsyncState
+{
+	FTransform Trigger1Transform;
+	FVector Trigger1Extent = FVector::ZeroVector;
+	FTransform Trigger2Transform;
+	FVector Trigger2Extent = FVector::ZeroVector;
+
+	/// <summary>
+	/// Player body, read on the physics thread (null without a player).
+	/// </summary>
+	Chaos::FSingleParticlePhysicsProxy* PlayerProxy = nullptr;
+};
+
 UCLASS()
 class FIXEDCAMERASYSTEM_API AFixedCameraTrigger : public AActor
 {
@@ -37,6 +66,31 @@ private:
 	/// Box collision trigger component 2.
 	/// </summary>
 	UBoxComponent* Trigger2;
+
+	/// <summary>
+	/// Player controller and root component whose changes are followed (game thread only).
+	/// </summary>
+	TWeakObjectPtr<APlayerController> PlayerController;
+	TWeakObjectPtr<UPrimitiveComponent> PlayerPrimitive;
+
+	/// <summary>
+	/// State published for the physics thread.
+	/// The sequence is odd while the game thread writes it, and the physics thread skips a step if it changed during the copy.
+	/// </summary>
+	FFixedCameraTriggerAsyncState AsyncState;
+	std::atomic<uint32> AsyncStateSequence;
+
+	/// <summary>
+	/// Player inside trigger 1 / 2 on the last physics step, and the state sequence they belong to (physics thread only).
+	/// </summary>
+	bool bPlayerInTrigger1;
+	bool bPlayerInTrigger2;
+	uint32 PhysicsStateSequence;
+
+	/// <summary>
+	/// Camera switches posted by the physics thread: 1 activates Camera1, 2 activates Camera2.
+	/// </summary>
+	TQueue<uint8, EQueueMode::Spsc> PendingSwitches;
 	
 public:	
 	/// <summary>
@@ -93,12 +147,33 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Trigger Settings", DisplayName = "Blend Exponent (Camera 2)", EditCondition = "Camera1 != nullptr && fSmoothTransition1 != 0", EditConditionHides, ClampMin = 0.f, Tooltip = "Smoothness blend exponent 2."))
 	float fBlendExp1;
 
+	/// <summary>
+	/// Evaluates the triggers at the fixed physics step instead of using overlap events (requires async physics, UE 5.2+).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Trigger Settings|Optimization", DisplayName = "Evaluate on Async Physics Tick", Tooltip = "Evaluates the triggers at the fixed physics step instead of using overlap events (requires async physics, UE 5.2+)."))
+	bool bEvaluateOnAsyncPhysicsTick;
+
 public:
 	/// <summary>
 	/// Sets default values for this actor's properties.
 	/// </summary>
 	AFixedCameraTrigger();
 
+	/// <summary>
+	/// Lays out the trigger boxes for the current scale and restarts their evaluation, so the trigger can be moved and reused.
+	/// </summary>
+	void ResetTrigger();
+
+	/// <summary>
+	/// Stops evaluating the player and forgets it, so a released trigger keeps no player state.
+	/// </summary>
+	void StopTrigger();
+
+	/// <summary>
+	/// Applies the camera switches posted by the physics thread, in order (called every frame by the subsystem).
+	/// </summary>
+	void ApplyPendingSwitches();
+
 private:
 	/// <summary>
 	/// Overlap event - Trigger 1.
@@ -144,12 +219,79 @@ private:
 	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera Trigger", Tooltip = "End overlap event - Trigger 2."))
 	void OnTriggerEndOverlap2(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 
+	/// <summary>
+	/// Deactivates camera 2 and activates camera 1.
+	/// </summary>
+	void SwitchToCamera1();
+
+	/// <summary>
+	/// Deactivates camera 1 and activates camera 2.
+	/// </summary>
+	void SwitchToCamera2();
+
+	/// <summary>
+	/// Places both trigger boxes side by side for the current actor scale.
+	/// </summary>
+	void LayoutTriggers();
+
+	/// <summary>
+	/// Follows the player pawn, publishes the trigger boxes and its body for the physics thread and starts the async physics tick.
+	/// </summary>
+	void StartAsyncPhysicsEvaluation();
+
+	/// <summary>
+	/// Follows the body of a player pawn, publishing it for the physics thread.
+	/// </summary>
+	/// <param name="Pawn">Possessed pawn (null if none).</param>
+	void TrackPlayerPawn(APawn* Pawn);
+
+	/// <summary>
+	/// Stops following the player controller and the player body.
+	/// </summary>
+	void ReleasePlayer();
+
+	/// <summary>
+	/// Publishes the trigger boxes and the player body for the physics thread, which restarts its evaluation.
+	/// </summary>
+	/// <param name="PlayerProxy">Player body (null if none).</param>
+	void PublishAsyncState(Chaos::FSingleParticlePhysicsProxy* PlayerProxy);
+
+	/// <summary>
+	/// Called when the player controller possesses another pawn.
+	/// </summary>
+	/// <param name="OldPawn">Previous pawn.</param>
+	/// <param name="NewPawn">Possessed pawn.</param>
+	UFUNCTION()
+	void OnPlayerPawnChanged(APawn* OldPawn, APawn* NewPawn);
+
+	/// <summary>
+	/// Called when the player body is created or destroyed, so the physics thread never reads a destroyed body.
+	/// </summary>
+	/// <param name="Component">Player root component.</param>
+	/// <param name="StateChange">Created or destroyed.</param>
+	UFUNCTION()
+	void OnPlayerPhysicsStateChanged(UPrimitiveComponent* Component, EComponentPhysicsStateChange StateChange);
+
+	/// <summary>
+	/// Returns true if the location is inside the cached trigger box.
+	/// </summary>
+	/// <param name="BoxTransform">Cached box world transform.</param>
+	/// <param name="BoxExtent">Cached box extent.</param>
+	/// <param name="Location">World location.</param>
+	static bool IsInTriggerBox(const FTransform& BoxTransform, const FVector& BoxExtent, const FVector& Location);
+
 protected:
 	/// <summary>
 	/// Called when the game starts or when spawned.
 	/// </summary>
 	virtual void BeginPlay() override;
 
+	/// <summary>
+	/// Called when the actor is removed from the level.
+	/// </summary>
+	/// <param name="EndPlayReason">End play reason.</param>
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/// <summary>
 	/// Called in Editor.
 	/// </summary>
@@ -161,4 +303,13 @@ public:
 	/// </summary>
 	/// <param name="DeltaTime"></param>
 	virtual void Tick(float DeltaTime) override;
+
+#if FIXEDCAMERA_WITH_ASYNC_PHYSICS_TICK
+	/// <summary>
+	/// Called on the physics thread at the fixed physics step.
+	/// </summary>
+	/// <param name="DeltaTime">Physics step.</param>
+	/// <param name="SimTime">Simulation time.</param>
+	virtual void AsyncPhysicsTickActor(float DeltaTime, float SimTime) override;
+#endif
 };
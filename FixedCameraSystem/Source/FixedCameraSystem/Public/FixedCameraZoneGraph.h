@@ -0,0 +1,302 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "FixedCameraActor.h"
+#include "FixedCameraPath.h"
+#include "FixedCameraZoneHulls.h"
+#include "FixedCameraZoneGraph.generated.h"
+
+UENUM()
+enum class EFixedCameraZoneShape
+{
+	Box              UMETA(DisplayName = "Box"),
+	Convex           UMETA(DisplayName = "Convex Prism"),
+	SplineExtrusion  UMETA(DisplayName = "Spline Extrusion")
+};
+
+USTRUCT(BlueprintType)
+struct FIXEDCAMERASYSTEM_API FFixedCameraZoneTransition
+{
+	GENERATED_BODY()
+
+	/// <summary>
+	/// Index of the adjacent zone.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone", DisplayName = "Target Zone", Tooltip = "Index of the adjacent zone."))
+	int32 TargetZone = INDEX_NONE;
+
+	/// <summary>
+	/// Smoothness transition quantity.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone", DisplayName = "Smooth Transition", ClampMin = 0.f, Tooltip = "Smoothness transition quantity."))
+	float fSmoothTransition = 0.f;
+
+	/// <summary>
+	/// Smoothness blend type.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone", DisplayName = "Blend Type", EditCondition = "fSmoothTransition != 0", EditConditionHides, Tooltip = "Smoothness blend type."))
+	TEnumAsByte<EViewTargetBlendFunction> BlendFunc = VTBlend_Linear;
+
+	/// <summary>
+	/// Smoothness blend exponent.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone", DisplayName = "Blend Exponent", EditCondition = "fSmoothTransition != 0", EditConditionHides, ClampMin = 0.f, Tooltip = "Smoothness blend exponent."))
+	float fBlendExp = 0.f;
+};
+
+USTRUCT(BlueprintType)
+struct FIXEDCAMERASYSTEM_API FFixedCameraZone
+{
+	GENERATED_BODY()
+
+	/// <summary>
+	/// Zone name, used by the camera lookup by zone.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone", DisplayName = "Zone Name", Tooltip = "Zone name, used by the camera lookup by zone."))
+	FName ZoneName;
+
+	/// <summary>
+	/// Fixed camera activated while the player is inside this zone.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone", Tooltip = "Fixed camera activated while the player is inside this zone."))
+	AFixedCameraActor* Camera = nullptr;
+
+	/// <summary>
+	/// Zone shape.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone", DisplayName = "Zone Shape", Tooltip = "Zone shape."))
+	EFixedCameraZoneShape Shape = EFixedCameraZoneShape::Box;
+
+	/// <summary>
+	/// Zone transform, relative to the graph actor.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone", DisplayName = "Zone Transform", MakeEditWidget, EditCondition = "Shape != EFixedCameraZoneShape::SplineExtrusion", EditConditionHides, Tooltip = "Zone transform, relative to the graph actor."))
+	FTransform ZoneTransform;
+
+	/// <summary>
+	/// Zone half size. Convex prisms only use Z (half height), spline extrusions use Y (half width) and Z (half height).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone", DisplayName = "Zone Extent", ClampMin = 0.f, Tooltip = "Zone half size. Convex prisms only use Z (half height), spline extrusions use Y (half width) and Z (half height)."))
+	FVector ZoneExtent = FVector(500.f, 500.f, 200.f);
+
+	/// <summary>
+	/// Prism base points, relative to the zone transform (only X and Y are used, the convex hull of the points is taken).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone", DisplayName = "Convex Points", MakeEditWidget, EditCondition = "Shape == EFixedCameraZoneShape::Convex", EditConditionHides, Tooltip = "Prism base points, relative to the zone transform (only X and Y are used, the convex hull of the points is taken)."))
+	TArray<FVector> ConvexPoints;
+
+	/// <summary>
+	/// Spline extruded along its length.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone", DisplayName = "Extrusion Path", EditCondition = "Shape == EFixedCameraZoneShape::SplineExtrusion", EditConditionHides, Tooltip = "Spline extruded along its length."))
+	AFixedCameraPath* ExtrusionPath = nullptr;
+
+	/// <summary>
+	/// Length of each convex segment of the extrusion.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone", DisplayName = "Extrusion Segment Length", EditCondition = "Shape == EFixedCameraZoneShape::SplineExtrusion", EditConditionHides, ClampMin = "10.0", Tooltip = "Length of each convex segment of the extrusion."))
+	float fExtrusionSegmentLength = 250.f;
+
+	/// <summary>
+	/// Adjacent zones and the blend used to reach each of them.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone", Tooltip = "Adjacent zones and the blend used to reach each of them."))
+	TArray<FFixedCameraZoneTransition> Transitions;
+};
+
+UCLASS()
+class FIXEDCAMERASYSTEM_API AFixedCameraZoneGraph : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	/// <summary>
+	/// Root scene component.
+	/// </summary>
+	UPROPERTY(VisibleDefaultsOnly, meta = (Category = "Fixed Camera Zone Graph"))
+	USceneComponent* Root;
+
+	/// <summary>
+	/// Camera zones. Only the neighbours of the current zone are tested each frame.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone Graph Settings", Tooltip = "Camera zones. Only the neighbours of the current zone are tested each frame."))
+	TArray<FFixedCameraZone> Zones;
+
+	/// <summary>
+	/// Searches every zone when the player leaves the current one through a non adjacent zone (teleports, respawns...).
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone Graph Settings", DisplayName = "Full Search Fallback", Tooltip = "Searches every zone when the player leaves the current one through a non adjacent zone (teleports, respawns...)."))
+	bool bFullSearchFallback = true;
+
+	/// <summary>
+	/// Draws the zones in the Editor viewport.
+	/// </summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Category = "Fixed Camera Zone Graph Settings", DisplayName = "Show Zones", Tooltip = "Draws the zones in the Editor viewport."))
+	bool bShowZones = true;
+
+private:
+	/// <summary>
+	/// Precomputed half-planes of every zone.
+	/// </summary>
+	FFixedCameraZoneHulls ZoneHulls;
+
+	/// <summary>
+	/// Number of tracked agents per zone.
+	/// </summary>
+	TArray<int32> ZoneOccupancy;
+
+	/// <summary>
+	/// Index of the zone the player is in.
+	/// </summary>
+	int32 CurrentZone;
+
+	/// <summary>
+	/// Player character reference.
+	/// </summary>
+	AActor* PlayerCharacterActorReference;
+
+public:
+	/// <summary>
+	/// Sets default values for this actor's properties.
+	/// </summary>
+	AFixedCameraZoneGraph();
+
+	/// <summary>
+	/// Called every frame.
+	/// </summary>
+	/// <param name="DeltaTime">Time between frames.</param>
+	virtual void Tick(float DeltaTime) override;
+
+	/// <summary>
+	/// Ticks in the Editor viewport to draw the zones.
+	/// </summary>
+	virtual bool ShouldTickIfViewportsOnly() const override;
+
+	/// <summary>
+	/// Returns the index of the zone the player is in.
+	/// </summary>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera Zone Graph", Tooltip = "Returns the index of the zone the player is in."))
+	int32 GetCurrentZone() const;
+
+	/// <summary>
+	/// Sets the zone the player is in without switching cameras (used to restore a snapshot).
+	/// </summary>
+	/// <param name="ZoneIndex">Zone index.</param>
+	void SetCurrentZone(int32 ZoneIndex);
+
+	/// <summary>
+	/// Returns true if the location is inside the zone.
+	/// </summary>
+	/// <param name="ZoneIndex">Zone index.</param>
+	/// <param name="Location">World location.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera Zone Graph", Tooltip = "Returns true if the location is inside the zone."))
+	bool IsInZone(int32 ZoneIndex, const FVector& Location) const;
+
+	/// <summary>
+	/// Returns the first zone containing the location, testing every zone.
+	/// </summary>
+	/// <param name="Location">World location.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera Zone Graph", Tooltip = "Returns the first zone containing the location, testing every zone."))
+	int32 FindZone(const FVector& Location) const;
+
+	/// <summary>
+	/// Returns the zones whose camera is the given one.
+	/// </summary>
+	/// <param name="Camera">Fixed camera.</param>
+	/// <param name="OutZones">Zone indices.</param>
+	void GetCameraZones(const AFixedCameraActor* Camera, TArray<int32>& OutZones) const;
+
+	/// <summary>
+	/// Adds the cameras of the zones adjacent to the zones of a camera.
+	/// </summary>
+	/// <param name="Camera">Fixed camera.</param>
+	/// <param name="OutCameras">Adjacent cameras (appended, unique).</param>
+	void GetAdjacentCameras(const AFixedCameraActor* Camera, TArray<AFixedCameraActor*>& OutCameras) const;
+
+	/// <summary>
+	/// Returns the zone of each location in a single vectorized pass.
+	/// </summary>
+	/// <param name="Locations">World locations.</param>
+	/// <param name="OutZones">Zone per location (INDEX_NONE if outside every zone).</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera Zone Graph", Tooltip = "Returns the zone of each location in a single vectorized pass."))
+	void FindZonesBatch(const TArray<FVector>& Locations, TArray<int32>& OutZones) const;
+
+	/// <summary>
+	/// Updates the zone of each tracked agent and the zone occupancy counts. Keep InOutZones between calls, only the agents that changed zone modify the counts.
+	/// </summary>
+	/// <param name="Locations">Agent world locations.</param>
+	/// <param name="InOutZones">Zone of each agent on the previous call, updated with the new zones.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera Zone Graph", Tooltip = "Updates the zone of each tracked agent and the zone occupancy counts. Keep InOutZones between calls, only the agents that changed zone modify the counts."))
+	void UpdateZoneOccupancy(const TArray<FVector>& Locations, UPARAM(ref) TArray<int32>& InOutZones);
+
+	/// <summary>
+	/// Returns the number of tracked agents inside a zone.
+	/// </summary>
+	/// <param name="ZoneIndex">Zone index.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera Zone Graph", Tooltip = "Returns the number of tracked agents inside a zone."))
+	int32 GetZoneOccupancy(int32 ZoneIndex) const;
+
+	/// <summary>
+	/// Removes the agents of a tracker from the occupancy counts and clears its zones, so that its next update starts from scratch.
+	/// </summary>
+	/// <param name="InOutZones">Zone of each agent of the tracker, emptied.</param>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera Zone Graph", Tooltip = "Removes the agents of a tracker from the occupancy counts and clears its zones, so that its next update starts from scratch."))
+	void ResetZoneOccupancy(UPARAM(ref) TArray<int32>& InOutZones);
+
+	/// <summary>
+	/// Rebuilds the zone half-planes. Call it after moving the graph, its zones or their splines at runtime.
+	/// </summary>
+	UFUNCTION(BlueprintCallable, meta = (Category = "Fixed Camera Zone Graph", Tooltip = "Rebuilds the zone half-planes. Call it after moving the graph, its zones or their splines at runtime."))
+	void RebuildZoneHulls();
+
+	/// <summary>
+	/// Returns the world space half-planes of each convex piece of a zone.
+	/// </summary>
+	/// <param name="ZoneIndex">Zone index.</param>
+	/// <param name="OutHulls">Convex pieces.</param>
+	void GetZoneHullPlanes(int32 ZoneIndex, TArray<TArray<FPlane>>& OutHulls) const;
+
+protected:
+	/// <summary>
+	/// Called when the game starts or when spawned.
+	/// </summary>
+	virtual void BeginPlay() override;
+
+	/// <summary>
+	/// Called when the actor is removed from the level.
+	/// </summary>
+	/// <param name="EndPlayReason">End play reason.</param>
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/// <summary>
+	/// Switches from the active camera to the new zone camera.
+	/// </summary>
+	/// <param name="NewZone">Zone entered by the player.</param>
+	/// <param name="Transition">Blend settings, nullptr for a cut.</param>
+	void EnterZone(int32 NewZone, const FFixedCameraZoneTransition* Transition);
+
+	/// <summary>
+	/// Returns the world space oriented boxes of a box or spline extrusion zone.
+	/// </summary>
+	/// <param name="Zone">Zone.</param>
+	/// <param name="OutBoxes">Box transforms (scale is the half size).</param>
+	void GetZoneBoxes(const FFixedCameraZone& Zone, TArray<FTransform>& OutBoxes) const;
+
+	/// <summary>
+	/// Returns the convex prism base points of a zone, in order, relative to the zone transform.
+	/// </summary>
+	/// <param name="Zone">Zone.</param>
+	/// <param name="OutPoints">Hull points.</param>
+	static void GetConvexHullPoints(const FFixedCameraZone& Zone, TArray<FVector>& OutPoints);
+
+	/// <summary>
+	/// Draws the zones and the transitions between them.
+	/// </summary>
+	void DrawZones() const;
+};
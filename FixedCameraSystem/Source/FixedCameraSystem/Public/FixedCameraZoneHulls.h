@@ -0,0 +1,103 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// <summary>
+/// Convex hulls of the camera zones stored as precomputed half-planes.
+/// Hulls are packed in groups of four so a point is tested against four hulls at once.
+/// A zone may own several hulls (e.g. the segments of a spline extrusion).
+/// </summary>
+struct FIXEDCAMERASYSTEM_API FFixedCameraZoneHulls
+{
+public:
+	/// <summary>
+	/// Removes every hull.
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// Adds a convex hull to a zone. The inside is where Plane.PlaneDot(Location) is not positive.
+	/// </summary>
+	/// <param name="ZoneIndex">Owner zone.</param>
+	/// <param name="Planes">World space half-planes.</param>
+	void AddHull(int32 ZoneIndex, const TArray<FPlane>& Planes);
+
+	/// <summary>
+	/// Packs the added hulls for the vectorized tests. Must be called after the last AddHull.
+	/// </summary>
+	/// <param name="NumZones">Number of zones.</param>
+	void Finalize(int32 NumZones);
+
+	/// <summary>
+	/// Returns true if the location is inside any hull of the zone.
+	/// </summary>
+	/// <param name="ZoneIndex">Zone index.</param>
+	/// <param name="Location">World location.</param>
+	bool IsInZone(int32 ZoneIndex, const FVector& Location) const;
+
+	/// <summary>
+	/// Returns the first zone containing the location, testing four hulls per step.
+	/// </summary>
+	/// <param name="Location">World location.</param>
+	int32 FindZone(const FVector& Location) const;
+
+	/// <summary>
+	/// Writes the first zone containing each location, testing four locations per step.
+	/// </summary>
+	/// <param name="Locations">World locations.</param>
+	/// <param name="OutZones">Zone per location (INDEX_NONE if outside every zone). Must have the same size as Locations.</param>
+	void FindZones(TArrayView<const FVector> Locations, TArrayView<int32> OutZones) const;
+
+	/// <summary>
+	/// Returns the number of hulls.
+	/// </summary>
+	int32 NumHulls() const { return HullZones.Num(); }
+
+private:
+	/// <summary>
+	/// Returns a bit per lane of the group whose hull contains the location.
+	/// </summary>
+	/// <param name="GroupIndex">Group of four hulls.</param>
+	/// <param name="Location">World location.</param>
+	int32 TestGroup(int32 GroupIndex, const FVector& Location) const;
+
+	/// <summary>
+	/// Hull planes before packing.
+	/// </summary>
+	TArray<TPair<int32, TArray<FPlane>>> PendingHulls;
+
+	/// <summary>
+	/// Owner zone of each packed hull.
+	/// </summary>
+	TArray<int32> HullZones;
+
+	/// <summary>
+	/// First packed hull of each zone (hulls are sorted by zone).
+	/// </summary>
+	TArray<int32> ZoneHullStart;
+
+	/// <summary>
+	/// Number of hulls of each zone.
+	/// </summary>
+	TArray<int32> ZoneHullCount;
+
+	/// <summary>
+	/// First plane row of each group.
+	/// </summary>
+	TArray<int32> GroupPlaneStart;
+
+	/// <summary>
+	/// Number of plane rows of each group.
+	/// </summary>
+	TArray<int32> GroupPlaneCount;
+
+	/// <summary>
+	/// Plane rows, four lanes (one per hull of the group) per row.
+	/// </summary>
+	TArray<float, TAlignedHeapAllocator<16>> PlaneX;
+	TArray<float, TAlignedHeapAllocator<16>> PlaneY;
+	TArray<float, TAlignedHeapAllocator<16>> PlaneZ;
+	TArray<float, TAlignedHeapAllocator<16>> PlaneW;
+};
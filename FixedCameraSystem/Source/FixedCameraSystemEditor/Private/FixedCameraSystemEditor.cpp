@@ -0,0 +1,147 @@
+// Copyright 2023 German Lopez. All Rights Reserved.
+
+#include "FixedCameraSystemEditor.h"
+#include "FixedCameraSystem.h"
+#include "PlacementMode/Public/IPlacementModeModule.h"
+#include "ActorFactories/ActorFactoryBlueprint.h"
+#include "Interfaces/IPluginManager.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "Styling/SlateStyleRegistry.h"
+#include "Styling/SlateTypes.h"
+#include "HAL/PlatformTime.h"
+
+#define LOCTEXT_NAMESPACE "FixedCameraSystem"
+
+namespace FixedCameraSystemEditor
+{
+	/// <summary>
+	/// Placement category of the plugin actors.
+	/// </summary>
+	static const FName PlacementCategory("FixedCamera");
+
+	/// <summary>
+	/// Blueprint registered as a placeable item.
+	/// </summary>
+	struct FPlaceableBlueprint
+	{
+		const TCHAR* Path;
+		const TCHAR* ThumbnailName;
+		const TCHAR* IconName;
+		const TCHAR* DisplayName;
+	};
+
+	static const FPlaceableBlueprint PlaceableBlueprints[] =
+	{
+		{ TEXT("/FixedCameraSystem/Blueprints/FixedCamera.FixedCamera"), TEXT("FixedCamera_Thumbnail"), TEXT("FixedCamera_Icon"), TEXT("Fixed Camera") },
+		{ TEXT("/FixedCameraSystem/Blueprints/FixedCameraRail.FixedCameraRail"), TEXT("Spline_Thumbnail"), TEXT("Spline_Icon"), TEXT("Fixed Camera | Path") },
+		{ TEXT("/FixedCameraSystem/Blueprints/FixedCameraTrigger.FixedCameraTrigger"), TEXT("Trigger_Thumbnail"), TEXT("Trigger_Icon"), TEXT("Fixed Camera | Trigger") },
+	};
+}
+
+/// <summary>
+/// Executed during module initialization.
+/// </summary>
+void FFixedCameraSystemEditorModule::StartupModule()
+{
+	const double fStartTime = FPlatformTime::Seconds();
+
+	// Only the category is registered now; its items are loaded the first time it is opened.
+	int Priority = 41;
+	FPlacementCategoryInfo FixedCameraSystem( LOCTEXT("FixedCamera", "Fixed Camera"), FixedCameraSystemEditor::PlacementCategory, TEXT("FixedCamera"), Priority);
+	IPlacementModeModule::Get().RegisterPlacementCategory(FixedCameraSystem);
+	CategoryRefreshedHandle = IPlacementModeModule::Get().OnPlacementModeCategoryRefreshed().AddRaw(this, &FFixedCameraSystemEditorModule::OnPlacementCategoryRefreshed);
+
+	// Brushes only store the file paths, the images are read when first drawn.
+	StyleSet = MakeShareable(new FSlateStyleSet("FixedCameraSystemStyle"));
+
+	FString CameraIconPath = IPluginManager::Get().FindPlugin(TEXT("FixedCameraSystem"))->GetBaseDir() + TEXT("/Resources/");
+
+	StyleSet->Set("FixedCamera_Thumbnail", new FSlateImageBrush(CameraIconPath + TEXT("FixedCamera_Thumbnail.png"), FVector2D(64.f, 64.f)));
+	StyleSet->Set("Spline_Thumbnail", new FSlateImageBrush(CameraIconPath + TEXT("Spline_Thumbnail.png"), FVector2D(64.f, 64.f)));
+	StyleSet->Set("Trigger_Thumbnail", new FSlateImageBrush(CameraIconPath + TEXT("Trigger_Thumbnail.png"), FVector2D(64.f, 64.f)));
+	StyleSet->Set("Target_Thumbnail", new FSlateImageBrush(CameraIconPath + TEXT("Target_Thumbnail.png"), FVector2D(64.f, 64.f)));
+
+	FSlateStyleRegistry::RegisterSlateStyle(*StyleSet.Get());
+
+	UE_LOG(LogFixedCameraSystem, Log, TEXT("Fixed Camera System editor module started in %.2f ms."), (FPlatformTime::Seconds() - fStartTime) * 1000.0);
+}
+
+/// <summary>
+/// Executed during module shutdown.
+/// </summary>
+void FFixedCameraSystemEditorModule::ShutdownModule()
+{
+	if (PlaceableItemsHandle.IsValid())
+	{
+		PlaceableItemsHandle->CancelHandle();
+		PlaceableItemsHandle.Reset();
+	}
+
+	if (IPlacementModeModule::IsAvailable())
+	{
+		IPlacementModeModule::Get().OnPlacementModeCategoryRefreshed().Remove(CategoryRefreshedHandle);
+		IPlacementModeModule::Get().UnregisterPlacementCategory(FixedCameraSystemEditor::PlacementCategory);
+	}
+
+	FSlateStyleRegistry::UnRegisterSlateStyle(*StyleSet.Get());
+	StyleSet.Reset();
+}
+
+/// <summary>
+/// Starts loading the placeable blueprints the first time the category is opened.
+/// </summary>
+/// <param name="CategoryName">Refreshed placement category.</param>
+void FFixedCameraSystemEditorModule::OnPlacementCategoryRefreshed(FName CategoryName)
+{
+	if (CategoryName != FixedCameraSystemEditor::PlacementCategory || PlaceableItemsHandle.IsValid())
+		return;
+
+	IPlacementModeModule::Get().OnPlacementModeCategoryRefreshed().Remove(CategoryRefreshedHandle);
+	CategoryRefreshedHandle.Reset();
+
+	TArray<FSoftObjectPath> BlueprintPaths;
+	for (const FixedCameraSystemEditor::FPlaceableBlueprint& PlaceableBlueprint : FixedCameraSystemEditor::PlaceableBlueprints)
+		BlueprintPaths.Add(FSoftObjectPath(PlaceableBlueprint.Path));
+
+	fLoadStartTime = FPlatformTime::Seconds();
+	PlaceableItemsHandle = StreamableManager.RequestAsyncLoad(BlueprintPaths, FStreamableDelegate::CreateRaw(this, &FFixedCameraSystemEditorModule::RegisterPlaceableItems));
+}
+
+/// <summary>
+/// Registers the loaded blueprints as placeable items.
+/// </summary>
+void FFixedCameraSystemEditorModule::RegisterPlaceableItems()
+{
+	IPlacementModeModule& PlacementModeModule = IPlacementModeModule::Get();
+
+	for (const FixedCameraSystemEditor::FPlaceableBlueprint& PlaceableBlueprint : FixedCameraSystemEditor::PlaceableBlueprints)
+	{
+		UBlueprint* Blueprint = Cast<UBlueprint>(FSoftObjectPath(PlaceableBlueprint.Path).ResolveObject());
+		if (!Blueprint)
+		{
+			UE_LOG(LogFixedCameraSystem, Warning, TEXT("Placeable blueprint %s could not be loaded."), PlaceableBlueprint.Path);
+			continue;
+		}
+
+		PlacementModeModule.RegisterPlaceableItem(FixedCameraSystemEditor::PlacementCategory, MakeShareable(new FPlaceableItem(
+			*UActorFactory::StaticClass(),
+			FAssetData(Blueprint, true),
+			FName(PlaceableBlueprint.ThumbnailName),
+			#if ENGINE_MAJOR_VERSION == 5
+				FName(PlaceableBlueprint.IconName),
+			#endif
+			TOptional<FLinearColor>(),
+			TOptional<int32>(),
+			FText::FromString(PlaceableBlueprint.DisplayName)
+		)));
+	}
+
+	UE_LOG(LogFixedCameraSystem, Log, TEXT("Fixed Camera System placeable items loaded in %.2f ms."), (FPlatformTime::Seconds() - fLoadStartTime) * 1000.0);
+
+	// The category was opened while loading, so it is shown again with the new items.
+	PlacementModeModule.RegenerateItemsForCategory(FixedCameraSystemEditor::PlacementCategory);
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FFixedCameraSystemEditorModule, FixedCameraSystemEditor)